@@ -0,0 +1,146 @@
+#pragma once
+
+#include "Utils.h"
+
+#include <stdint.h>
+#include <new> /* ::operator new, std::align_val_t, std::bad_alloc */
+#include <type_traits> /* std::true_type */
+
+#ifdef __linux__
+#include <sys/mman.h> /* mmap, munmap, madvise */
+#endif
+
+/* Allocator whose blocks all start at a multiple of Alignment bytes, so Data() of an Array using it
+   stays aligned across every reallocation (e.g. 32 for AVX, 64 for AVX-512 and cache lines) */
+template<typename T, uint64_t Alignment>
+class AlignedAllocator final
+{
+	static_assert((Alignment & (Alignment - 1u)) == 0u, "AlignedAllocator<T, Alignment> > Alignment must be a power of 2!");
+	static_assert(Alignment >= alignof(T), "AlignedAllocator<T, Alignment> > Alignment must be at least alignof(T)!");
+
+public:
+	using value_type = T;
+	using is_always_equal = std::true_type;
+
+	template<typename U>
+	struct rebind
+	{
+		using other = AlignedAllocator<U, Alignment>;
+	};
+
+	/* Array keeps its elements at the start of the block for allocators that have this, so Data() stays aligned */
+	static constexpr uint64_t BlockAlignment{ Alignment };
+
+	constexpr AlignedAllocator() = default;
+	template<typename U>
+	constexpr AlignedAllocator(const AlignedAllocator<U, Alignment>&) {}
+
+	__NODISCARD T* allocate(const size_t n)
+	{
+		return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t{ Alignment }));
+	}
+
+	void deallocate(T* const pData, const size_t)
+	{
+		::operator delete(pData, std::align_val_t{ Alignment });
+	}
+
+	constexpr bool operator==(const AlignedAllocator&) const { return true; }
+	constexpr bool operator!=(const AlignedAllocator&) const { return false; }
+};
+
+/* Allocator for multi-GB Arrays: blocks of at least HugePageSize get their own 2 MiB aligned mapping
+   marked with MADV_HUGEPAGE so they are backed by transparent huge pages, which cuts TLB misses.
+   With Populate the pages are faulted in up front instead of on first touch.
+   Smaller blocks, and every block on platforms without transparent huge pages, use AlignedAllocator */
+template<typename T, uint64_t Alignment = 64u, bool Populate = false>
+class HugePageAllocator final
+{
+public:
+	using value_type = T;
+	using is_always_equal = std::true_type;
+
+	template<typename U>
+	struct rebind
+	{
+		using other = HugePageAllocator<U, Alignment, Populate>;
+	};
+
+	static constexpr uint64_t HugePageSize{ 2ull * 1024ull * 1024ull };
+	static constexpr uint64_t BlockAlignment{ Alignment };
+
+	constexpr HugePageAllocator() = default;
+	template<typename U>
+	constexpr HugePageAllocator(const HugePageAllocator<U, Alignment, Populate>&) {}
+
+	__NODISCARD T* allocate(const size_t n)
+	{
+#ifdef __linux__
+		const uint64_t bytes{ n * sizeof(T) };
+
+		if (bytes >= HugePageSize)
+			return static_cast<T*>(MapHugePages(RoundToHugePage(bytes)));
+#endif
+
+		return AlignedAllocator<T, Alignment>{}.allocate(n);
+	}
+
+	void deallocate(T* const pData, const size_t n)
+	{
+#ifdef __linux__
+		const uint64_t bytes{ n * sizeof(T) };
+
+		if (bytes >= HugePageSize)
+		{
+			munmap(pData, RoundToHugePage(bytes));
+			return;
+		}
+#endif
+
+		AlignedAllocator<T, Alignment>{}.deallocate(pData, n);
+	}
+
+	constexpr bool operator==(const HugePageAllocator&) const { return true; }
+	constexpr bool operator!=(const HugePageAllocator&) const { return false; }
+
+private:
+#ifdef __linux__
+	__NODISCARD static constexpr uint64_t RoundToHugePage(const uint64_t bytes)
+	{
+		return (bytes + HugePageSize - 1u) & ~(HugePageSize - 1u);
+	}
+
+	__NODISCARD static void* MapHugePages(const uint64_t size)
+	{
+		/* mmap only guarantees 4 KiB alignment, so map an extra huge page and cut off the unaligned ends */
+		unsigned char* const pMapping{ static_cast<unsigned char*>(
+			mmap(nullptr, size + HugePageSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0)) };
+
+		if (pMapping == MAP_FAILED)
+			throw std::bad_alloc{};
+
+		unsigned char* const pData{ reinterpret_cast<unsigned char*>(
+			(reinterpret_cast<uintptr_t>(pMapping) + HugePageSize - 1u) & ~(HugePageSize - 1u)) };
+
+		if (pData != pMapping)
+			munmap(pMapping, static_cast<uint64_t>(pData - pMapping));
+
+		munmap(pData + size, static_cast<uint64_t>(pMapping + HugePageSize - pData));
+
+		madvise(pData, size, MADV_HUGEPAGE);
+
+		if constexpr (Populate)
+		{
+			/* Fault the pages in after madvise so the faults are served with huge pages */
+#ifdef MADV_POPULATE_WRITE
+			if (madvise(pData, size, MADV_POPULATE_WRITE) == 0)
+				return pData;
+#endif
+			for (uint64_t offset{}; offset < size; offset += 4096u)
+				pData[offset] = 0;
+		}
+
+		return pData;
+	}
+#endif
+};
@@ -0,0 +1,210 @@
+#pragma once
+
+#include "Utils.h"
+
+#include <stdint.h>
+#include <cstring> /* std::memcpy */
+#include <new> /* ::operator new, std::bad_alloc */
+
+/* Monotonic bump allocator: allocating is a pointer increment, deallocating does nothing (unless it was the last allocation)
+   and Reset() makes the whole arena available again in O(1) while keeping its memory around for the next frame */
+class Arena final
+{
+public:
+	explicit Arena(const uint64_t blockSize = 64u * 1024u)
+		: m_pFirstBlock{}
+		, m_pCurrentBlock{}
+		, m_pCurrent{}
+		, m_pEnd{}
+		, m_BlockSize{ blockSize }
+	{}
+
+	~Arena()
+	{
+		Release();
+	}
+
+	Arena(const Arena&) noexcept = delete;
+	Arena(Arena&&) noexcept = delete;
+	Arena& operator=(const Arena&) noexcept = delete;
+	Arena& operator=(Arena&&) noexcept = delete;
+
+	__NODISCARD void* Allocate(const uint64_t bytes, const uint64_t alignment)
+	{
+		unsigned char* pData{ AlignUp(m_pCurrent, alignment) };
+
+		if (!m_pCurrent || pData + bytes > m_pEnd)
+		{
+			NextBlock(bytes + alignment);
+			pData = AlignUp(m_pCurrent, alignment);
+		}
+
+		m_pCurrent = pData + bytes;
+
+		return pData;
+	}
+
+	/* Only the most recent allocation can be given back, everything else is abandoned until Reset() */
+	void Deallocate(void* const pData, const uint64_t bytes)
+	{
+		if (static_cast<unsigned char*>(pData) + bytes == m_pCurrent)
+			m_pCurrent = static_cast<unsigned char*>(pData);
+	}
+
+	/* Grows the most recent allocation without moving it, returns false if that is not possible */
+	__NODISCARD bool TryGrow(void* const pData, const uint64_t oldBytes, const uint64_t newBytes)
+	{
+		unsigned char* const pBytes{ static_cast<unsigned char*>(pData) };
+
+		if (pBytes + oldBytes != m_pCurrent || pBytes + newBytes > m_pEnd)
+			return false;
+
+		m_pCurrent = pBytes + newBytes;
+
+		return true;
+	}
+
+	/* Makes every block available again, everything allocated from the arena is invalid afterwards */
+	void Reset()
+	{
+		m_pCurrentBlock = m_pFirstBlock;
+
+		if (m_pCurrentBlock)
+		{
+			m_pCurrent = m_pCurrentBlock->Data();
+			m_pEnd = m_pCurrent + m_pCurrentBlock->Size;
+		}
+	}
+
+	/* Gives all blocks back to the system */
+	void Release()
+	{
+		while (m_pFirstBlock)
+		{
+			Block* const pNext{ m_pFirstBlock->pNext };
+			::operator delete(m_pFirstBlock);
+			m_pFirstBlock = pNext;
+		}
+
+		m_pCurrentBlock = nullptr;
+		m_pCurrent = nullptr;
+		m_pEnd = nullptr;
+	}
+
+	__NODISCARD uint64_t GetUsedBytesInBlock() const
+	{
+		return m_pCurrentBlock ? static_cast<uint64_t>(m_pCurrent - m_pCurrentBlock->Data()) : 0u;
+	}
+
+private:
+	struct Block final
+	{
+		Block* pNext;
+		uint64_t Size;
+
+		unsigned char* Data() { return reinterpret_cast<unsigned char*>(this + 1); }
+	};
+
+	__NODISCARD static unsigned char* AlignUp(unsigned char* const pData, const uint64_t alignment)
+	{
+		const uintptr_t address{ reinterpret_cast<uintptr_t>(pData) };
+
+		return reinterpret_cast<unsigned char*>((address + alignment - 1u) & ~(alignment - 1u));
+	}
+
+	void NextBlock(const uint64_t minSize)
+	{
+		/* Reuse the blocks kept around by Reset() before asking the system for a new one */
+		if (m_pCurrentBlock && m_pCurrentBlock->pNext && m_pCurrentBlock->pNext->Size >= minSize)
+		{
+			m_pCurrentBlock = m_pCurrentBlock->pNext;
+		}
+		else
+		{
+			uint64_t size{ m_pCurrentBlock ? m_pCurrentBlock->Size * 2u : m_BlockSize };
+			if (size < minSize)
+				size = minSize;
+
+			Block* const pBlock{ static_cast<Block*>(::operator new(sizeof(Block) + size)) };
+			pBlock->Size = size;
+
+			if (m_pCurrentBlock)
+			{
+				pBlock->pNext = m_pCurrentBlock->pNext;
+				m_pCurrentBlock->pNext = pBlock;
+			}
+			else
+			{
+				pBlock->pNext = m_pFirstBlock;
+				m_pFirstBlock = pBlock;
+			}
+
+			m_pCurrentBlock = pBlock;
+		}
+
+		m_pCurrent = m_pCurrentBlock->Data();
+		m_pEnd = m_pCurrent + m_pCurrentBlock->Size;
+	}
+
+	Block* m_pFirstBlock;
+	Block* m_pCurrentBlock;
+	unsigned char* m_pCurrent;
+	unsigned char* m_pEnd;
+	uint64_t m_BlockSize;
+};
+
+/* Allocator handing out memory from an Arena, growing an Array abandons its old block inside the arena
+   (or grows it in place when it was the last allocation) */
+template<typename T>
+class ArenaAllocator final
+{
+public:
+	using value_type = T;
+
+	constexpr ArenaAllocator(Arena* const pArena)
+		: m_pArena{ pArena }
+	{}
+	template<typename U>
+	constexpr ArenaAllocator(const ArenaAllocator<U>& other)
+		: m_pArena{ other.GetArena() }
+	{}
+
+	__NODISCARD T* allocate(const size_t n)
+	{
+		return static_cast<T*>(m_pArena->Allocate(n * sizeof(T), alignof(T)));
+	}
+
+	void deallocate(T* const pData, const size_t n)
+	{
+		m_pArena->Deallocate(pData, n * sizeof(T));
+	}
+
+	__NODISCARD T* reallocate(T* const pData, const size_t oldN, const size_t newN)
+	{
+		if (m_pArena->TryGrow(pData, oldN * sizeof(T), newN * sizeof(T)))
+			return pData;
+
+		/* The freed tail of an older block cannot be reused anyway, moving would only waste another block's worth */
+		if (newN <= oldN)
+			return pData;
+
+		T* const pNewData{ allocate(newN) };
+
+		std::memcpy(static_cast<void*>(pNewData), static_cast<const void*>(pData), (oldN < newN ? oldN : newN) * sizeof(T));
+
+		return pNewData;
+	}
+
+	__NODISCARD constexpr Arena* GetArena() const
+	{
+		return m_pArena;
+	}
+
+	template<typename U>
+	constexpr bool operator==(const ArenaAllocator<U>& other) const { return m_pArena == other.GetArena(); }
+	template<typename U>
+	constexpr bool operator!=(const ArenaAllocator<U>& other) const { return m_pArena != other.GetArena(); }
+
+private:
+	Arena* m_pArena;
+};
@@ -3,143 +3,233 @@
 #include "Utils.h"
 #include "Types.h"
 #include "Iterator.h"
+#include "GrowthPolicy.h"
+#include "Sorting.h"
+#include "AlignedAllocator.h"
 
+#include <concepts> /* std::same_as */
+#include <cstring> /* std::memmove */
 #include <functional> /* std::function */
-
-template<typename T>
+#include <limits> /* std::numeric_limits */
+#include <memory> /* std::allocator, std::allocator_traits */
+#include <memory_resource> /* std::pmr::polymorphic_allocator */
+#include <new> /* placement new */
+#include <span> /* std::span */
+
+/* InlineCapacity > 0 makes the Array store up to that many elements inside the object itself,
+   it only allocates once it grows beyond it (see SmallArray).
+   The live elements do not have to start at the beginning of the block: keeping free room in front of them
+   makes adding and removing at the front amortized O(1), like at the back */
+template<typename T, typename Alloc = std::allocator<T>, typename GrowthPolicy = OneAndAHalfGrowth, uint64_t InlineCapacity = 0>
 class Array
 {
 	using UnaryPred = std::function<bool(const T&)>;
 	using BinaryPred = std::function<bool(const T&, const T&)>;
+	using AllocTraits = std::allocator_traits<Alloc>;
+
+	static_assert(std::is_same_v<typename AllocTraits::value_type, T>, "Array<T, Alloc> > Alloc::value_type must be T!");
 
 public:
 	using It = Iterator<T>;
 	using CIt = ConstIterator<T>;
+	using AllocatorType = Alloc;
+
+	/* Selection vector of positions into an Array, Index can be uint32_t to halve its size */
+	template<typename Index = uint64_t>
+	using IndexArray = Array<Index, typename AllocTraits::template rebind_alloc<Index>>;
 
 #pragma region Ctors and Dtor
 	constexpr Array()
-		: m_pHead{}
-		, m_pTail{}
-		, m_pCurrentEnd{}
+		: m_pBuffer{ InlineData() }
+		, m_pHead{ InlineData() }
+		, m_pTail{ InlineData() + InlineCapacity }
+		, m_pCurrentEnd{ InlineData() }
+		, m_NrOfRecycled{}
+		, m_Alloc{}
 	{}
-	constexpr Array(const Size_P size)
-		: m_pHead{}
-		, m_pTail{}
-		, m_pCurrentEnd{}
-	{
-		for (uint64_t i{}; i < size._Size; ++i)
-			EmplaceBack(T{});
-	}
-	constexpr Array(const Size_P size, const T& val)
-		: m_pHead{}
-		, m_pTail{}
-		, m_pCurrentEnd{}
-	{
-		for (uint64_t i{}; i < size._Size; ++i)
-			EmplaceBack(val);
-	}
-	constexpr Array(const Capacity_P cap)
-		: m_pHead{}
-		, m_pTail{}
-		, m_pCurrentEnd{}
+	constexpr explicit Array(const Alloc& alloc)
+		: m_pBuffer{ InlineData() }
+		, m_pHead{ InlineData() }
+		, m_pTail{ InlineData() + InlineCapacity }
+		, m_pCurrentEnd{ InlineData() }
+		, m_NrOfRecycled{}
+		, m_Alloc{ alloc }
+	{}
+	constexpr Array(const Size_P size, const Alloc& alloc = Alloc{})
+		: m_pBuffer{ InlineData() }
+		, m_pHead{ InlineData() }
+		, m_pTail{ InlineData() + InlineCapacity }
+		, m_pCurrentEnd{ InlineData() }
+		, m_NrOfRecycled{}
+		, m_Alloc{ alloc }
+	{
+		AppendDefault(size._Size);
+	}
+	constexpr Array(const Size_P size, const T& val, const Alloc& alloc = Alloc{})
+		: m_pBuffer{ InlineData() }
+		, m_pHead{ InlineData() }
+		, m_pTail{ InlineData() + InlineCapacity }
+		, m_pCurrentEnd{ InlineData() }
+		, m_NrOfRecycled{}
+		, m_Alloc{ alloc }
+	{
+		AppendFill(size._Size, val);
+	}
+	constexpr Array(const Capacity_P cap, const Alloc& alloc = Alloc{})
+		: m_pBuffer{ InlineData() }
+		, m_pHead{ InlineData() }
+		, m_pTail{ InlineData() + InlineCapacity }
+		, m_pCurrentEnd{ InlineData() }
+		, m_NrOfRecycled{}
+		, m_Alloc{ alloc }
 	{
 		Reserve(cap._Capacity);
 	}
-	constexpr Array(std::initializer_list<T> init)
-		: m_pHead{}
-		, m_pTail{}
-		, m_pCurrentEnd{}
+	constexpr Array(std::initializer_list<T> init, const Alloc& alloc = Alloc{})
+		: m_pBuffer{ InlineData() }
+		, m_pHead{ InlineData() }
+		, m_pTail{ InlineData() + InlineCapacity }
+		, m_pCurrentEnd{ InlineData() }
+		, m_NrOfRecycled{}
+		, m_Alloc{ alloc }
 	{
-		for (const T& elem : init)
-			EmplaceBack(elem);
+		AppendRange(init.begin(), init.size());
 	}
-	constexpr Array(It beg, It end)
-		: m_pHead{}
-		, m_pTail{}
-		, m_pCurrentEnd{}
+	constexpr Array(It beg, It end, const Alloc& alloc = Alloc{})
+		: m_pBuffer{ InlineData() }
+		, m_pHead{ InlineData() }
+		, m_pTail{ InlineData() + InlineCapacity }
+		, m_pCurrentEnd{ InlineData() }
+		, m_NrOfRecycled{}
+		, m_Alloc{ alloc }
 	{
-		for (; beg != end; ++beg)
-			EmplaceBack(*beg);
+		__ASSERT(beg <= end && "Array::Array() > beg cannot be past end");
+
+		AppendRange(beg.operator->(), static_cast<uint64_t>(end - beg));
 	}
 
 	constexpr ~Array()
 	{
+		DestroyRecycled();
 		DeleteData(m_pHead, m_pCurrentEnd);
-		Release(m_pHead);
+		Release(m_pBuffer, Capacity());
 	}
 #pragma endregion
 
 #pragma region Rule of 5
 	constexpr Array(const Array& other) noexcept
-		: m_pHead{}
-		, m_pTail{}
-		, m_pCurrentEnd{}
+		: m_pBuffer{ InlineData() }
+		, m_pHead{ InlineData() }
+		, m_pTail{ InlineData() + InlineCapacity }
+		, m_pCurrentEnd{ InlineData() }
+		, m_NrOfRecycled{}
+		, m_Alloc{ AllocTraits::select_on_container_copy_construction(other.m_Alloc) }
 	{
-		const uint64_t cap{ other.Capacity() };
-		if (cap > 0u)
-		{
-			m_pHead = new T[cap]{};
-			m_pTail = m_pHead + cap;
-
-			const uint64_t size{ other.Size() };
-			for (uint64_t i{}; i < size; ++i)
-				new (m_pHead + i) T{ *(other.m_pHead + i) }; // dont allow moving 
-
-			m_pCurrentEnd = m_pHead + size;
-		}
+		CopyFrom(other);
 	}
 	constexpr Array(Array&& other) noexcept
-		: m_pHead{ __MOVE(other.m_pHead) }
+		: m_pBuffer{ __MOVE(other.m_pBuffer) }
+		, m_pHead{ __MOVE(other.m_pHead) }
 		, m_pTail{ __MOVE(other.m_pTail) }
 		, m_pCurrentEnd{ __MOVE(other.m_pCurrentEnd) }
+		, m_NrOfRecycled{ other.m_NrOfRecycled }
+		, m_Alloc{ __MOVE(other.m_Alloc) }
 	{
-		other.m_pHead = nullptr;
-		other.m_pTail = nullptr;
-		other.m_pCurrentEnd = nullptr;
+		if constexpr (InlineCapacity > 0)
+		{
+			/* Inline elements live inside other, so they have to be moved over one by one */
+			if (other.IsInline())
+			{
+				other.DestroyRecycled();
+				ResetPointers();
+
+				MoveRangeBackward(other.m_pHead, other.m_pCurrentEnd, m_pHead);
+				m_pCurrentEnd = m_pHead + other.Size();
+			}
+		}
+
+		other.ResetPointers();
 	}
 
 	constexpr Array& operator=(const Array& other) noexcept
 	{
-		if (m_pHead)
+		if (this == &other)
+			return *this;
+
+		DestroyRecycled();
+
+		bool bReuseBlock{ other.Size() <= Capacity() };
+
+		if constexpr (AllocTraits::propagate_on_container_copy_assignment::value && !AllocTraits::is_always_equal::value)
 		{
-			DeleteData(m_pHead, m_pCurrentEnd);
-			Release(m_pHead);
+			/* Our block has to be given back to the allocator that handed it out */
+			bReuseBlock &= m_Alloc == other.m_Alloc;
 		}
 
-		m_pHead = nullptr;
-		m_pTail = nullptr;
-		m_pCurrentEnd = nullptr;
-
-		const uint64_t cap{ other.Capacity() };
-		if (cap > 0u)
+		if (!bReuseBlock)
 		{
-			m_pHead = new T[cap]{};
-			m_pTail = m_pHead + cap;
+			DeleteData(m_pHead, m_pCurrentEnd);
+			Release(m_pBuffer, Capacity());
 
-			const uint64_t size{ other.Size() };
-			for (uint64_t i{}; i < size; ++i)
-				new (m_pHead + i) T{ *(other.m_pHead + i) }; // dont allow moving 
+			ResetPointers();
 
-			m_pCurrentEnd = m_pHead + size;
+			if constexpr (AllocTraits::propagate_on_container_copy_assignment::value)
+				m_Alloc = other.m_Alloc;
+
+			CopyFrom(other);
+
+			return *this;
 		}
 
+		if constexpr (AllocTraits::propagate_on_container_copy_assignment::value)
+			m_Alloc = other.m_Alloc;
+
+		AssignFrom(other);
+
 		return *this;
 	}
 	constexpr Array& operator=(Array&& other) noexcept
 	{
-		if (m_pHead)
+		if (this == &other)
+			return *this;
+
+		DestroyRecycled();
+
+		bool bMoveElements{ other.IsInline() };
+
+		if constexpr (!AllocTraits::propagate_on_container_move_assignment::value && !AllocTraits::is_always_equal::value)
 		{
-			DeleteData(m_pHead, m_pCurrentEnd);
-			Release(m_pHead);
+			/* We cannot steal memory that our allocator did not hand out */
+			bMoveElements |= m_Alloc != other.m_Alloc;
+		}
+
+		if (bMoveElements)
+		{
+			Clear();
+			Reserve(other.Size());
+
+			const uint64_t size{ other.Size() };
+			for (uint64_t i{}; i < size; ++i)
+				EmplaceBack(__MOVE(*(other.m_pHead + i)));
+
+			other.Clear();
+
+			return *this;
 		}
 
+		DeleteData(m_pHead, m_pCurrentEnd);
+		Release(m_pBuffer, Capacity());
+
+		m_pBuffer = __MOVE(other.m_pBuffer);
 		m_pHead = __MOVE(other.m_pHead);
 		m_pTail = __MOVE(other.m_pTail);
 		m_pCurrentEnd = __MOVE(other.m_pCurrentEnd);
+		m_NrOfRecycled = other.m_NrOfRecycled;
 
-		other.m_pHead = nullptr;
-		other.m_pTail = nullptr;
-		other.m_pCurrentEnd = nullptr;
+		if constexpr (AllocTraits::propagate_on_container_move_assignment::value)
+			m_Alloc = __MOVE(other.m_Alloc);
+
+		other.ResetPointers();
 
 		return *this;
 	}
@@ -166,20 +256,19 @@ public:
 
 	constexpr void AddRange(std::initializer_list<T> elems)
 	{
-		for (const T& elem : elems)
-			EmplaceBack(elem);
+		AppendRange(elems.begin(), elems.size());
 	}
 	constexpr void AddRange(It beg, It end)
 	{
-		for (; beg != end; ++beg)
-			EmplaceBack(*beg);
+		__ASSERT(beg <= end && "Array::AddRange() > beg cannot be past end");
+
+		AppendRange(beg.operator->(), static_cast<uint64_t>(end - beg));
 	}
-	constexpr void AddRange(T* pArr, const uint64_t n)
+	constexpr void AddRange(const T* pArr, const uint64_t n)
 	{
 		__ASSERT(pArr != nullptr);
 
-		for (uint64_t i{}; i < n; ++i)
-			EmplaceBack(pArr[i]);
+		AppendRange(pArr, n);
 	}
 
 	constexpr It EraseByIndex(const uint64_t index)
@@ -202,8 +291,9 @@ public:
 		}
 		else
 		{
-			(m_pHead + index)->~T();
+			AllocTraits::destroy(m_Alloc, m_pHead + index);
 			MoveRangeBackward(m_pHead + index + 1, m_pCurrentEnd--, m_pHead + index);
+			CloseRecycledGap(1u);
 
 			return It{ m_pHead + index };
 		}
@@ -213,7 +303,7 @@ public:
 	{
 		__ASSERT(pos != end() && "Array::Erase() > invalid iterator was passed as a parameter");
 
-		return Erase(*pos);
+		return EraseByIndex(static_cast<uint64_t>(pos - begin()));
 	}
 	constexpr It Erase(const T& val)
 	{
@@ -229,7 +319,7 @@ public:
 		It it{ Find(pred) };
 
 		if (it != end())
-			return Erase(*it);
+			return Erase(it);
 
 		return end();
 	}
@@ -238,17 +328,46 @@ public:
 		It it{ Find(__MOVE(pred)) };
 
 		if (it != end())
-			return Erase(*it);
+			return Erase(it);
 
 		return end();
 	}
 
-	constexpr void EraseRange(const uint64_t start, const uint64_t count)
+	/* Erases count elements starting at start (or everything after start if there are fewer).
+	   start + count is the first element that is kept, see the changelog in README.md */
+	constexpr void EraseRange(const uint64_t start, uint64_t count)
 	{
 		__ASSERT(start < Size() && "Array::EraseRange() > Start is out of range");
 
-		EraseRange(It{ m_pHead + start }, It{ m_pHead + start + count });
+		const uint64_t size{ Size() };
+
+		if (count > size - start)
+			count = size - start;
+
+		if (count == 0u)
+			return;
+
+		T* const pFirst{ m_pHead + start };
+		T* const pLast{ pFirst + count };
+
+		/* Destroy the range and then shift the elements behind it over it once, erasing from the front just moves the head */
+		DeleteData(pFirst, pLast);
+
+		if (start == 0u && CanHaveFrontGap)
+		{
+			m_pHead += count;
+
+			if (m_pHead == m_pCurrentEnd && m_NrOfRecycled == 0u)
+				m_pHead = m_pCurrentEnd = m_pBuffer;
+		}
+		else
+		{
+			MoveRangeBackward(pLast, m_pCurrentEnd, pFirst);
+			m_pCurrentEnd -= count;
+			CloseRecycledGap(count);
+		}
 	}
+	/* Erases [beg, endIt], endIt included */
 	constexpr void EraseRange(It beg, It endIt)
 	{
 		__ASSERT(beg != end() && "Array::EraseRange() > Cannot iterator past the end");
@@ -256,8 +375,126 @@ public:
 		if (endIt >= end())
 			endIt = It{ m_pCurrentEnd - 1 };
 
-		for (; beg <= endIt; --endIt)
-			beg = Erase(beg);
+		if (endIt < beg)
+			return;
+
+		EraseRange(static_cast<uint64_t>(beg - begin()), static_cast<uint64_t>(endIt - beg) + 1u);
+	}
+
+	/* The EraseUnordered functions fill the hole with the last element in O(1), so the order of the elements is not kept */
+	constexpr It EraseUnordered(const uint64_t index)
+	{
+		__ASSERT(index < Size() && "Array::EraseUnordered() > index is out of range");
+
+		T* const pHole{ m_pHead + index };
+
+		AllocTraits::destroy(m_Alloc, pHole);
+
+		if (pHole != --m_pCurrentEnd)
+			MoveRangeBackward(m_pCurrentEnd, m_pCurrentEnd + 1, pHole);
+
+		CloseRecycledGap(1u);
+
+		return It{ pHole };
+	}
+	constexpr It EraseUnordered(It pos)
+	{
+		__ASSERT(pos != end() && "Array::EraseUnordered() > invalid iterator was passed as a parameter");
+
+		return EraseUnordered(static_cast<uint64_t>(pos - begin()));
+	}
+	constexpr It EraseUnordered(const T& val)
+	{
+		It it{ Find(val) };
+
+		if (it != end())
+			return EraseUnordered(it);
+
+		return end();
+	}
+	constexpr It EraseUnordered(const UnaryPred& pred)
+	{
+		It it{ Find(pred) };
+
+		if (it != end())
+			return EraseUnordered(it);
+
+		return end();
+	}
+
+	/* Erases every element matching pred, filling the holes with elements from the back. Returns the amount removed */
+	template<typename Pred>
+	constexpr uint64_t RemoveIfUnordered(const Pred& pred)
+	{
+		T* pElem{ m_pHead };
+		T* pEnd{ m_pCurrentEnd };
+
+		while (pElem < pEnd)
+		{
+			if (pred(*pElem))
+			{
+				/* The element we move in still has to be checked */
+				if (pElem != --pEnd)
+					*pElem = __MOVE(*pEnd);
+			}
+			else
+				++pElem;
+		}
+
+		const uint64_t nrOfRemoved{ static_cast<uint64_t>(m_pCurrentEnd - pEnd) };
+
+		DeleteData(pEnd, m_pCurrentEnd);
+		m_pCurrentEnd = pEnd;
+		CloseRecycledGap(nrOfRemoved);
+
+		return nrOfRemoved;
+	}
+
+	/* Erases every element matching pred in a single pass, keeping the order of the others. Returns the amount removed */
+	template<typename Pred>
+	constexpr uint64_t RemoveIf(const Pred& pred)
+	{
+		T* pWrite{ m_pHead };
+
+		if constexpr (std::is_trivially_copyable_v<T>)
+		{
+			/* Branchless: every element gets written, but pWrite only moves on past the ones we keep */
+			for (T* pRead{ m_pHead }; pRead < m_pCurrentEnd; ++pRead)
+			{
+				const T val{ *pRead };
+				*pWrite = val;
+				pWrite += !static_cast<bool>(pred(val));
+			}
+		}
+		else
+		{
+			/* Elements in front of the first match are already in place */
+			while (pWrite < m_pCurrentEnd && !pred(*pWrite))
+				++pWrite;
+
+			for (T* pRead{ pWrite }; pRead < m_pCurrentEnd; ++pRead)
+				if (!pred(*pRead))
+					*pWrite++ = __MOVE(*pRead);
+		}
+
+		const uint64_t nrOfRemoved{ static_cast<uint64_t>(m_pCurrentEnd - pWrite) };
+
+		DeleteData(pWrite, m_pCurrentEnd);
+		m_pCurrentEnd = pWrite;
+		CloseRecycledGap(nrOfRemoved);
+
+		return nrOfRemoved;
+	}
+	constexpr uint64_t RemoveAll(const T& val)
+	{
+		/* val might be one of our own elements, which gets overwritten while compacting */
+		if (&val >= m_pHead && &val < m_pCurrentEnd)
+		{
+			const T copy{ val };
+			return RemoveIf([&copy](const T& elem)->bool { return elem == copy; });
+		}
+
+		return RemoveIf([&val](const T& elem)->bool { return elem == val; });
 	}
 
 	constexpr void Insert(const uint64_t index, const T& val)
@@ -268,13 +505,93 @@ public:
 	{
 		Emplace(index, __MOVE(val));
 	}
+	constexpr void InsertRange(const uint64_t index, It beg, It end)
+	{
+		__ASSERT(beg <= end && "Array::InsertRange() > beg cannot be past end");
+
+		InsertRange(index, beg.operator->(), static_cast<uint64_t>(end - beg));
+	}
+	constexpr void InsertRange(const uint64_t index, std::initializer_list<T> elems)
+	{
+		InsertRange(index, elems.begin(), elems.size());
+	}
+	constexpr void InsertRange(const uint64_t index, const T* pArr, const uint64_t n)
+	{
+		__ASSERT(index <= Size() && "Array::InsertRange() > index is out of range");
+
+		if (n == 0u)
+			return;
+
+		/* Inserting part of ourselves, the source would get shifted around while we open the gap */
+		if (pArr >= m_pHead && pArr < m_pCurrentEnd)
+		{
+			Array copy{ m_Alloc };
+			copy.AppendRange(pArr, n);
+
+			InsertRange(index, copy.m_pHead, n);
+			return;
+		}
+
+		T* const pGap{ OpenGap(index, n) };
+
+		if constexpr (std::is_trivially_copyable_v<T>)
+		{
+			std::memcpy(static_cast<void*>(pGap), static_cast<const void*>(pArr), n * sizeof(T));
+		}
+		else
+		{
+			uint64_t i{};
+
+			try
+			{
+				for (; i < n; ++i)
+					AllocTraits::construct(m_Alloc, pGap + i, *(pArr + i));
+			}
+			catch (...)
+			{
+				CloseGap(index, n, i);
+				throw;
+			}
+		}
+	}
+	constexpr void InsertN(const uint64_t index, const uint64_t n, const T& val)
+	{
+		__ASSERT(index <= Size() && "Array::InsertN() > index is out of range");
+
+		if (n == 0u)
+			return;
+
+		/* val might be one of our own elements */
+		if (&val >= m_pHead && &val < m_pCurrentEnd)
+		{
+			const T copy{ val };
+
+			InsertN(index, n, copy);
+			return;
+		}
+
+		T* const pGap{ OpenGap(index, n) };
+		uint64_t i{};
+
+		try
+		{
+			for (; i < n; ++i)
+				AllocTraits::construct(m_Alloc, pGap + i, val);
+		}
+		catch (...)
+		{
+			CloseGap(index, n, i);
+			throw;
+		}
+	}
 
 	constexpr void Pop()
 	{
 		if (Size() == 0)
 			return;
 
-		(--m_pCurrentEnd)->~T();
+		AllocTraits::destroy(m_Alloc, --m_pCurrentEnd);
+		CloseRecycledGap(1u);
 	}
 
 	constexpr void PopFront()
@@ -282,26 +599,72 @@ public:
 		if (Size() == 0)
 			return;
 
-		m_pHead->~T();
+		if constexpr (!CanHaveFrontGap)
+		{
+			AllocTraits::destroy(m_Alloc, m_pHead);
+			MoveRangeBackward(m_pHead + 1, m_pCurrentEnd--, m_pHead);
+			CloseRecycledGap(1u);
+
+			return;
+		}
+
+		AllocTraits::destroy(m_Alloc, m_pHead++);
+
+		/* Once we are empty all room can go to the back again, unless recycled objects are still sitting there */
+		if (m_pHead == m_pCurrentEnd && m_NrOfRecycled == 0u)
+			m_pHead = m_pCurrentEnd = m_pBuffer;
+	}
+
+	/* Empties the Array without destroying its elements: they stay alive behind the end and get reused by EmplaceBack and Reacquire,
+	   so Arrays of strings or Arrays that get refilled every frame keep their inner buffers. Trivially destructible elements are just cleared.
+	   Adding, inserting and erasing leave the recycled objects alive, only changing the capacity (Reserve, ShrinkToFit, growing) destroys them */
+	constexpr void ResetKeepObjects()
+	{
+		if constexpr (std::is_trivially_destructible_v<T>)
+		{
+			Clear();
+		}
+		else
+		{
+			m_NrOfRecycled += Size();
+			m_pCurrentEnd = m_pHead;
+		}
+	}
+
+	/* Adds an element to the back, handing out a recycled object as it was left (not reset!) if there is one */
+	constexpr T& Reacquire()
+	{
+		if (m_NrOfRecycled > 0u)
+		{
+			--m_NrOfRecycled;
+			return *m_pCurrentEnd++;
+		}
 
-		MoveRangeBackward(m_pHead + 1, m_pCurrentEnd--, m_pHead);
+		return EmplaceBack();
 	}
 
 	constexpr void Clear()
 	{
+		DestroyRecycled();
+
 		DeleteData(m_pHead, m_pCurrentEnd);
 
-		m_pCurrentEnd = m_pHead;
+		m_pHead = m_pCurrentEnd = m_pBuffer;
 	}
 
 	template<typename ... Ts>
 	constexpr T& EmplaceBack(Ts&&... args)
 	{
+		if (m_NrOfRecycled > 0u)
+			return EmplaceRecycled(__FORWARD(args)...);
+
 		/* if we point past our allocated memory we have an issue */
 		if (!m_pCurrentEnd || m_pCurrentEnd >= m_pTail)
-			Reallocate();
+			ReserveForAppend(1u);
+
+		AllocTraits::construct(m_Alloc, m_pCurrentEnd, __FORWARD(args)...);
 
-		return *(new (m_pCurrentEnd++) T{ __FORWARD(args)... });
+		return *m_pCurrentEnd++;
 	}
 
 	template<typename ... Ts>
@@ -309,32 +672,40 @@ public:
 	{
 		__ASSERT(index <= Size() && "Array::Emplace() > index is out of range");
 
-		const uint64_t oldSize{ Size() };
+		if (index == Size())
+			return EmplaceBack(__FORWARD(args)...);
 
-		if (oldSize + 1 > Capacity())
-			Reallocate();
+		T* const pGap{ OpenGap(index, 1u) };
 
-		if (index == 0)
-			return EmplaceFront(__FORWARD(args)...);
-		else if (oldSize == 0 || index == oldSize || index == oldSize - 1)
-			return EmplaceBack(__FORWARD(args)...);
-		else
+		try
+		{
+			AllocTraits::construct(m_Alloc, pGap, __FORWARD(args)...);
+		}
+		catch (...)
 		{
-			MoveRangeForward(m_pHead + index, m_pCurrentEnd++ - 1, m_pHead + index + 1);
-			return *(new (m_pHead + index) T{ __FORWARD(args)... });
+			CloseGap(index, 1u, 0u);
+			throw;
 		}
+
+		return *pGap;
 	}
 
+	/* The front operations (EmplaceFront, PopFront, inserting or erasing at index 0) use the room in front of the elements,
+	   so unlike inserting or erasing anywhere else they don't move the elements behind them */
 	template<typename ... Ts>
 	constexpr T& EmplaceFront(Ts&&... args)
 	{
-		/* if we point past our allocated memory we have an issue */
-		if (!m_pCurrentEnd || m_pCurrentEnd >= m_pTail)
-			Reallocate();
+		if constexpr (!CanHaveFrontGap)
+		{
+			return Emplace(0u, __FORWARD(args)...);
+		}
+
+		if (m_pHead == m_pBuffer)
+			ReserveForPrepend(1u);
 
-		MoveRangeForward(m_pHead, m_pCurrentEnd++, m_pHead + 1);
+		AllocTraits::construct(m_Alloc, m_pHead - 1, __FORWARD(args)...);
 
-		return *(new (m_pHead) T{ __FORWARD(args)... });
+		return *--m_pHead;
 	}
 #pragma endregion
 
@@ -349,9 +720,10 @@ public:
 		return m_pCurrentEnd - m_pHead;
 	}
 
+	/* The size of the whole block, including the free room in front of the elements */
 	__NODISCARD constexpr uint64_t Capacity() const
 	{
-		return m_pTail - m_pHead;
+		return m_pTail - m_pBuffer;
 	}
 
 	__NODISCARD constexpr uint64_t MaxSize() const
@@ -359,6 +731,11 @@ public:
 		return std::numeric_limits<uint64_t>::max();
 	}
 
+	__NODISCARD constexpr Alloc GetAllocator() const
+	{
+		return m_Alloc;
+	}
+
 	__NODISCARD constexpr bool operator==(const Array& other) const
 	{
 		const uint64_t size{ Size() };
@@ -383,48 +760,92 @@ public:
 	constexpr void Reserve(const uint64_t newCap)
 	{
 		if (newCap > Capacity())
+		{
 			if (newCap < MaxSize())
 				ReallocateExactly(newCap);
+		}
+		else if (newCap > static_cast<uint64_t>(m_pTail - m_pHead))
+		{
+			/* The block is big enough, but part of it is in front of our elements */
+			Slide(0u);
+		}
 	}
 
 	constexpr void Resize(const uint64_t newSize)
 	{
 		static_assert(std::is_default_constructible_v<T>, "Array::Resize() > T is not default constructable!");
 
-		Resize(newSize, T{});
+		const uint64_t oldSize{ Size() };
+
+		if (newSize > oldSize)
+			AppendDefault(newSize - oldSize);
+		else
+			ShrinkTo(newSize);
 	}
 	template<typename U>
 	constexpr void Resize(const uint64_t newSize, U&& val)
 	{
-		static_assert(std::is_default_constructible_v<U>, "Array::Resize() > T is not default constructable!");
-		static_assert(std::is_same_v<T, U>, "Array::Resize() > U and T must be the same!");
+		static_assert(std::is_same_v<T, std::remove_cvref_t<U>>, "Array::Resize() > U and T must be the same!");
 
 		const uint64_t oldSize{ Size() };
 
 		if (newSize > oldSize)
-		{
-			const uint64_t diff{ newSize - oldSize };
+			AppendFill(newSize - oldSize, val);
+		else
+			ShrinkTo(newSize);
+	}
 
-			for (uint64_t i{}; i < diff; ++i)
-				EmplaceBack(__FORWARD(val));
+	/* Grows without initialising the new elements, they hold garbage until they are written to.
+	   Only for implicit-lifetime types, so meant for buffers that get filled from a file or socket right after */
+	constexpr void ResizeUninitialized(const uint64_t newSize)
+	{
+		static_assert(std::is_trivially_default_constructible_v<T> && std::is_trivially_destructible_v<T>,
+			"Array::ResizeUninitialized() > T must be an implicit-lifetime type!");
 
-			return;
-		}
+		const uint64_t oldSize{ Size() };
 
-		if (newSize < oldSize)
-		{
-			const uint64_t diff{ oldSize - newSize };
+		if (newSize > oldSize)
+			ReserveForAppend(newSize - oldSize);
+
+		m_pCurrentEnd = m_pHead + newSize;
+	}
+	/* Grows by default-initialising the new elements, which leaves trivial types uninitialised */
+	constexpr void ResizeDefaultInit(const uint64_t newSize)
+	{
+		static_assert(std::is_default_constructible_v<T>, "Array::ResizeDefaultInit() > T is not default constructable!");
 
-			for (uint64_t i{}; i < diff; ++i)
-				Pop();
+		const uint64_t oldSize{ Size() };
 
+		if (newSize <= oldSize)
+		{
+			ShrinkTo(newSize);
 			return;
 		}
+
+		while (m_NrOfRecycled > 0u && Size() < newSize)
+			EmplaceRecycled();
+
+		ReserveForAppend(newSize - Size());
+
+		if constexpr (!std::is_trivially_default_constructible_v<T>)
+			for (; m_pCurrentEnd < m_pHead + newSize; ++m_pCurrentEnd)
+				::new (static_cast<void*>(m_pCurrentEnd)) T;
+
+		m_pCurrentEnd = m_pHead + newSize;
+	}
+	/* Appends n uninitialised elements and returns them, for producers to write into directly */
+	__NODISCARD constexpr std::span<T> GrowBy(const uint64_t n)
+	{
+		const uint64_t oldSize{ Size() };
+
+		ResizeUninitialized(oldSize + n);
+
+		return std::span<T>{ m_pHead + oldSize, n };
 	}
 
 	constexpr void ShrinkToFit()
 	{
-		if (Size() == Capacity())
+		if (Size() == Capacity() || IsInline())
 			return;
 
 		ReallocateExactly(Size());
@@ -434,7 +855,7 @@ public:
 	{
 		const uint64_t size{ Size() };
 
-		Array arr{ Capacity_P{ size } };
+		Array arr{ Capacity_P{ size }, m_Alloc };
 
 		for (uint64_t i{}; i < size; ++i)
 		{
@@ -450,7 +871,7 @@ public:
 	{
 		const uint64_t size{ Size() };
 
-		Array arr{ Capacity_P{ size } };
+		Array arr{ Capacity_P{ size }, m_Alloc };
 
 		for (uint64_t i{}; i < size; ++i)
 		{
@@ -465,46 +886,94 @@ public:
 
 	constexpr void Sort() const
 	{
-		Sort([](const T& a, const T& b)->bool
+		StableSort(m_pHead, Size(), [](const T& a, const T& b)->bool
 			{
 				return a < b;
 			});
 	}
 	constexpr void Sort(const BinaryPred& pred) const
 	{
-		if (!m_pHead)
-			return;
-
-		const uint64_t size{ Size() };
-
-		if (size < 64u)
-			InsertionSort(pred);
-		else
-			MergeSort(0u, size - 1u, pred);
+		StableSort(m_pHead, Size(), pred);
 	}
-#pragma endregion
-
-#pragma region Accessing Elements
-	constexpr T& Front()
+	constexpr void Sort(const SortMode mode) const
 	{
-		__ASSERT(Size() > 0 && "Array::Front() > Array is empty");
-
-		return *m_pHead;
+		SortWithMode(m_pHead, Size(), [](const T& a, const T& b)->bool
+			{
+				return a < b;
+			}, mode);
 	}
-	constexpr const T& Front() const
+	constexpr void Sort(const BinaryPred& pred, const SortMode mode) const
 	{
-		__ASSERT(Size() > 0 && "Array::Front() > Array is empty");
-
-		return *m_pHead;
+		SortWithMode(m_pHead, Size(), pred, mode);
 	}
 
-	constexpr T& Back()
+	/* Faster than Sort() but equal elements can end up in any order */
+	constexpr void SortUnstable() const
 	{
-		__ASSERT(Size() > 0 && "Array::Back() > Array is empty");
-
-		return *(m_pCurrentEnd - 1);
-	}
-	constexpr const T& Back() const
+		UnstableSort(m_pHead, Size(), [](const T& a, const T& b)->bool
+			{
+				return a < b;
+			});
+	}
+	constexpr void SortUnstable(const BinaryPred& pred) const
+	{
+		UnstableSort(m_pHead, Size(), pred);
+	}
+
+	/* Stable radix sort, for arrays of integers, floating points or enums */
+	void RadixSort() const
+	{
+		LsdRadixSort(m_pHead, Size(), [](const T& value)->const T&
+			{
+				return value;
+			});
+	}
+	/* Stable radix sort on the integer, floating point or enum key keyOf(element) returns */
+	template<typename KeyOf>
+	void RadixSort(const KeyOf& keyOf) const
+	{
+		LsdRadixSort(m_pHead, Size(), keyOf);
+	}
+
+	/* Stable sort on every thread of the pool, small arrays are sorted like Sort() does */
+	void ParallelSort() const
+	{
+		ParallelStableSort(m_pHead, Size(), [](const T& a, const T& b)->bool
+			{
+				return a < b;
+			});
+	}
+	void ParallelSort(const BinaryPred& pred) const
+	{
+		ParallelStableSort(m_pHead, Size(), pred);
+	}
+	void ParallelSort(const BinaryPred& pred, ThreadPool& pool) const
+	{
+		ParallelStableSort(m_pHead, Size(), pred, pool);
+	}
+#pragma endregion
+
+#pragma region Accessing Elements
+	constexpr T& Front()
+	{
+		__ASSERT(Size() > 0 && "Array::Front() > Array is empty");
+
+		return *m_pHead;
+	}
+	constexpr const T& Front() const
+	{
+		__ASSERT(Size() > 0 && "Array::Front() > Array is empty");
+
+		return *m_pHead;
+	}
+
+	constexpr T& Back()
+	{
+		__ASSERT(Size() > 0 && "Array::Back() > Array is empty");
+
+		return *(m_pCurrentEnd - 1);
+	}
+	constexpr const T& Back() const
 	{
 		__ASSERT(Size() > 0 && "Array::Back() > Array is empty");
 
@@ -542,6 +1011,27 @@ public:
 		return m_pHead;
 	}
 
+	__NODISCARD constexpr std::span<T> Span()
+	{
+		return std::span<T>{ m_pHead, Size() };
+	}
+	__NODISCARD constexpr std::span<const T> Span() const
+	{
+		return std::span<const T>{ m_pHead, Size() };
+	}
+	__NODISCARD constexpr std::span<T> Span(const uint64_t start, const uint64_t count)
+	{
+		__ASSERT(start + count <= Size() && "Array::Span() > Range is out of range");
+
+		return std::span<T>{ m_pHead + start, count };
+	}
+	__NODISCARD constexpr std::span<const T> Span(const uint64_t start, const uint64_t count) const
+	{
+		__ASSERT(start + count <= Size() && "Array::Span() > Range is out of range");
+
+		return std::span<const T>{ m_pHead + start, count };
+	}
+
 	constexpr It Find(const T& val) const
 	{
 		const uint64_t size{ Size() };
@@ -572,7 +1062,7 @@ public:
 
 	constexpr Array FindAll(const T& val) const
 	{
-		Array arr{};
+		Array arr{ m_Alloc };
 
 		const uint64_t size{ Size() };
 		for (uint64_t i{}; i < size; ++i)
@@ -583,7 +1073,7 @@ public:
 	}
 	constexpr Array FindAll(const UnaryPred& pred) const
 	{
-		Array arr{};
+		Array arr{ m_Alloc };
 
 		const uint64_t size{ Size() };
 		for (uint64_t i{}; i < size; ++i)
@@ -594,7 +1084,7 @@ public:
 	}
 	constexpr Array FindAll(UnaryPred&& pred) const
 	{
-		Array arr{};
+		Array arr{ m_Alloc };
 
 		const uint64_t size{ Size() };
 		for (uint64_t i{}; i < size; ++i)
@@ -603,6 +1093,98 @@ public:
 
 		return arr;
 	}
+
+	/* Appends the matches to out instead of returning a new Array */
+	constexpr void FindAll(const T& val, Array& out) const
+	{
+		__ASSERT(&out != this && "Array::FindAll() > out cannot be the Array itself");
+
+		const uint64_t size{ Size() };
+		for (uint64_t i{}; i < size; ++i)
+			if (*(m_pHead + i) == val)
+				out.EmplaceBack(*(m_pHead + i));
+	}
+	template<typename Pred>
+	constexpr void Select(const Pred& pred, Array& out) const
+	{
+		__ASSERT(&out != this && "Array::Select() > out cannot be the Array itself");
+
+		const uint64_t size{ Size() };
+		for (uint64_t i{}; i < size; ++i)
+			if (pred(*(m_pHead + i)))
+				out.EmplaceBack(*(m_pHead + i));
+	}
+
+	/* The Indices functions return the positions of the matches instead of copies of them,
+	   so filters can be chained on the positions and only the final result gets materialized with Gather() */
+	template<typename Index = uint64_t>
+	__NODISCARD constexpr IndexArray<Index> FindAllIndices(const T& val) const
+	{
+		return SelectIndices<Index>([&val](const T& elem)->bool { return elem == val; });
+	}
+	template<typename Index = uint64_t, typename Pred>
+	__NODISCARD constexpr IndexArray<Index> SelectIndices(const Pred& pred) const
+	{
+		IndexArray<Index> indices{ typename IndexArray<Index>::AllocatorType{ m_Alloc } };
+
+		SelectIndices(pred, indices);
+
+		/* Room was made for every position, don't hand out a mostly empty block */
+		if (indices.Size() < indices.Capacity() / 2u)
+			indices.ShrinkToFit();
+
+		return indices;
+	}
+	/* Appends the positions of the matches to out. out needs room for Size() more indices while filling,
+	   and keeps that capacity afterwards, so reusing out for several selections only pays for it once */
+	template<typename Index, typename Pred>
+	constexpr void SelectIndices(const Pred& pred, IndexArray<Index>& out) const
+	{
+		static_assert(std::is_unsigned_v<Index>, "Array::SelectIndices() > Index must be an unsigned integer!");
+
+		if constexpr (std::is_same_v<IndexArray<Index>, Array>)
+		{
+			__ASSERT(&out != this && "Array::SelectIndices() > out cannot be the Array itself");
+		}
+
+		const uint64_t size{ Size() };
+
+		__ASSERT(size <= std::numeric_limits<Index>::max() && "Array::SelectIndices() > Index is too small for this Array");
+
+		/* Branchless: every position gets written, but only the matches are kept */
+		const uint64_t oldSize{ out.Size() };
+		Index* const pOut{ out.GrowBy(size).data() };
+
+		uint64_t nrOfMatches{};
+		for (uint64_t i{}; i < size; ++i)
+		{
+			*(pOut + nrOfMatches) = static_cast<Index>(i);
+			nrOfMatches += static_cast<bool>(pred(*(m_pHead + i)));
+		}
+
+		out.ResizeUninitialized(oldSize + nrOfMatches);
+	}
+	/* Removes the positions of elements not matching pred from selection */
+	template<typename Index, typename Pred>
+	constexpr void RefineIndices(IndexArray<Index>& selection, const Pred& pred) const
+	{
+		selection.RemoveIf([this, &pred](const Index index)->bool { return !pred(*(m_pHead + index)); });
+	}
+	/* Appends copies of the selected elements to out */
+	template<typename Index>
+	constexpr void Gather(const IndexArray<Index>& selection, Array& out) const
+	{
+		__ASSERT(&out != this && "Array::Gather() > out cannot be the Array itself");
+
+		out.Reserve(out.Size() + selection.Size());
+
+		for (const Index index : selection)
+		{
+			__ASSERT(index < Size() && "Array::Gather() > index is out of range");
+
+			out.EmplaceBack(*(m_pHead + index));
+		}
+	}
 #pragma endregion
 
 #pragma region Iterators
@@ -617,183 +1199,540 @@ public:
 #pragma endregion
 
 private:
+	/* Allocators such as ReallocAllocator can resize a block without us moving the elements */
+	static constexpr bool CanReallocateInPlace{ IsTriviallyRelocatable_v<T> &&
+		requires(Alloc& alloc, T* pData, uint64_t n) { { alloc.reallocate(pData, n, n) } -> std::same_as<T*>; } };
+
+	/* Allocators that align their blocks (AlignedAllocator, HugePageAllocator) promise an aligned Data(),
+	   so the elements never get room in front of them and the front operations shift them instead */
+	static constexpr bool CanHaveFrontGap{ !requires { Alloc::BlockAlignment; } };
+
 #pragma region Internal Helpers
-	constexpr void Reallocate()
+	/* Moves the elements to a block of newCap elements, leaving frontGap free slots in front of them */
+	constexpr void ReallocateExactly(const uint64_t newCap, const uint64_t frontGap = 0u)
 	{
+		DestroyRecycled();
+
 		const uint64_t oldSize{ Size() };
-		const uint64_t newCap{ CalculateNewCapacity(oldSize + 1) };
 
-		T* pOldHead{ m_pHead };
-		T* pOldTail{ m_pTail };
+		T* pOldBuffer{ m_pBuffer };
+		T* const pOldHead{ m_pHead };
+		const uint64_t oldCap{ Capacity() };
 
-		m_pHead = new T[newCap]{};
-		m_pTail = m_pHead + newCap;
+		/* Blocks that fit in the inline buffer go there instead of the heap */
+		const bool bToInline{ InlineCapacity > 0 && newCap <= InlineCapacity };
 
-		for (uint64_t i{}; i < oldSize; ++i)
+		if (bToInline && IsInline())
 		{
-			if constexpr (std::is_move_assignable_v<T>)
-				new (m_pHead + i) T{ __MOVE(*(pOldHead + i)) };
-			else
-				new (m_pHead + i) T{ *(pOldHead + i) };
+			Slide(frontGap);
+			return;
+		}
+
+		/* Nothing to move, just give the block back instead of asking for an empty one (realloc(p, 0) frees p) */
+		if (newCap == 0u && !bToInline)
+		{
+			Release(pOldBuffer, oldCap);
+
+			m_pBuffer = m_pHead = m_pTail = m_pCurrentEnd = nullptr;
+
+			return;
+		}
+
+		if constexpr (CanReallocateInPlace)
+		{
+			/* Let the allocator grow the block itself (realloc, mremap, ...), the bytes are moved without us touching them */
+			if (pOldBuffer && !IsInline() && !bToInline && frontGap == 0u)
+			{
+				/* The allocator only keeps the start of the block */
+				Slide(0u);
+
+				m_pBuffer = m_pHead = m_Alloc.reallocate(pOldBuffer, oldCap, newCap);
+				m_pTail = m_pBuffer + newCap;
+				m_pCurrentEnd = m_pHead + oldSize;
+
+				return;
+			}
 		}
 
+		/* Only the live elements get moved over, the rest of the new block stays raw memory */
+		m_pBuffer = bToInline ? InlineData() : Allocate(newCap);
+		m_pTail = m_pBuffer + (bToInline ? InlineCapacity : newCap);
+		m_pHead = m_pBuffer + frontGap;
+
+		MoveRangeBackward(pOldHead, pOldHead + oldSize, m_pHead);
+
 		m_pCurrentEnd = m_pHead + oldSize;
 
-		DeleteData(pOldHead, pOldTail);
-		Release(pOldHead);
+		Release(pOldBuffer, oldCap);
+	}
+
+	/* Moves the elements inside our block so that there are frontGap free slots in front of them */
+	constexpr void Slide(const uint64_t frontGap)
+	{
+		DestroyRecycled();
+
+		T* const pNewHead{ m_pBuffer + frontGap };
+		const uint64_t size{ Size() };
+
+		if (pNewHead < m_pHead)
+			MoveRangeBackward(m_pHead, m_pCurrentEnd, pNewHead);
+		else if (pNewHead > m_pHead)
+			MoveRangeForward(m_pHead, m_pCurrentEnd, pNewHead);
+
+		m_pHead = pNewHead;
+		m_pCurrentEnd = pNewHead + size;
+	}
+
+	/* Sliding the elements around instead of growing only pays off when it frees up a lot of room */
+	__NODISCARD constexpr bool ShouldSlide(const uint64_t n) const
+	{
+		const uint64_t newSize{ Size() + n };
+
+		return newSize <= Capacity() / 2u || (IsInline() && newSize <= Capacity());
+	}
+
+	__NODISCARD constexpr T* Allocate(const uint64_t cap)
+	{
+		return AllocTraits::allocate(m_Alloc, cap);
+	}
+
+	constexpr void Release(T*& pData, const uint64_t cap)
+	{
+		if (pData && pData != InlineData())
+		{
+			AllocTraits::deallocate(m_Alloc, pData, cap);
+			pData = nullptr;
+		}
 	}
-	constexpr void ReallocateExactly(const uint64_t newCap)
+
+	/* Turns [index, index + n) into raw memory by moving the elements behind it once, growing at most once.
+	   Opening a gap at the front uses the room in front of the elements instead. The caller has to construct the n new elements */
+	__NODISCARD constexpr T* OpenGap(const uint64_t index, const uint64_t n)
 	{
 		const uint64_t oldSize{ Size() };
 
-		T* pOldHead{ m_pHead };
-		T* pOldTail{ m_pTail };
+		if (index == 0u && oldSize > 0u && CanHaveFrontGap)
+		{
+			ReserveForPrepend(n);
 
-		m_pHead = new T[newCap]{};
-		m_pTail = m_pHead + newCap;
+			m_pHead -= n;
+
+			return m_pHead;
+		}
 
-		for (uint64_t i{}; i < oldSize; ++i)
+		if constexpr (!CanReallocateInPlace)
 		{
-			if constexpr (std::is_move_assignable_v<T>)
-				new (m_pHead + i) T{ __MOVE(*(pOldHead + i)) };
-			else
-				new (m_pHead + i) T{ *(pOldHead + i) };
+			if (static_cast<uint64_t>(m_pTail - m_pCurrentEnd) < n && !(m_pHead != m_pBuffer && ShouldSlide(n)))
+			{
+				DestroyRecycled();
+
+				/* Move the head and tail straight to their final place in the new block */
+				const uint64_t newCap{ CalculateNewCapacity(oldSize + n) };
+
+				T* pOldBuffer{ m_pBuffer };
+				T* const pOldHead{ m_pHead };
+				const uint64_t oldCap{ Capacity() };
+
+				m_pBuffer = m_pHead = Allocate(newCap);
+				m_pTail = m_pBuffer + newCap;
+
+				MoveRangeBackward(pOldHead, pOldHead + index, m_pHead);
+				MoveRangeBackward(pOldHead + index, pOldHead + oldSize, m_pHead + index + n);
+
+				m_pCurrentEnd = m_pHead + oldSize + n;
+
+				Release(pOldBuffer, oldCap);
+
+				return m_pHead + index;
+			}
 		}
 
-		m_pCurrentEnd = m_pHead + oldSize;
+		ReserveForAppend(n);
+
+		/* Only the recycled objects the elements get shifted onto have to go, the others end up right behind the end again */
+		const uint64_t nrOfOverwritten{ n < m_NrOfRecycled ? n : m_NrOfRecycled };
+		DeleteData(m_pCurrentEnd, m_pCurrentEnd + nrOfOverwritten);
+		m_NrOfRecycled -= nrOfOverwritten;
+
+		MoveRangeForward(m_pHead + index, m_pCurrentEnd, m_pHead + index + n);
+
+		m_pCurrentEnd += n;
 
-		DeleteData(pOldHead, pOldTail);
-		Release(pOldHead);
+		return m_pHead + index;
 	}
 
-	constexpr void Release(T*& pData)
+	/* Undoes OpenGap(index, n) when constructing the new elements threw, the first nrOfConstructed of them already exist */
+	constexpr void CloseGap(const uint64_t index, const uint64_t n, const uint64_t nrOfConstructed)
 	{
-		if (pData)
+		T* const pGap{ m_pHead + index };
+
+		DeleteData(pGap, pGap + nrOfConstructed);
+
+		/* A gap at the front was taken from the room in front of the elements */
+		if (index == 0u && CanHaveFrontGap)
 		{
-			delete[] pData;
-			pData = nullptr;
+			m_pHead += n;
+			return;
 		}
+
+		MoveRangeBackward(pGap + n, m_pCurrentEnd, pGap);
+		m_pCurrentEnd -= n;
+		CloseRecycledGap(n);
 	}
 
-	constexpr void DeleteData(T* head, T* const tail) const
+	constexpr void ShrinkTo(const uint64_t newSize)
 	{
-		if constexpr (!std::is_trivially_destructible_v<T>)
+		const uint64_t nrOfRemoved{ Size() - newSize };
+
+		DeleteData(m_pHead + newSize, m_pCurrentEnd);
+
+		m_pCurrentEnd = m_pHead + newSize;
+		CloseRecycledGap(nrOfRemoved);
+	}
+
+	/* Assigns over the first recycled object when given a T, instead of constructing a new one.
+	   Anything else gets constructed, assigning it could give a different value than constructing from it (std::string = char) */
+	template<typename ... Ts>
+	constexpr T& EmplaceRecycled(Ts&&... args)
+	{
+		--m_NrOfRecycled;
+
+		if constexpr (sizeof...(Ts) == 1u && ((std::is_same_v<std::remove_cvref_t<Ts>, T> && std::is_assignable_v<T&, Ts&&>) && ...))
 		{
-			while (head < tail)
+			((*m_pCurrentEnd = __FORWARD(args)), ...);
+		}
+		else
+		{
+			AllocTraits::destroy(m_Alloc, m_pCurrentEnd);
+
+			try
 			{
-				head->~T();
-				++head;
+				AllocTraits::construct(m_Alloc, m_pCurrentEnd, __FORWARD(args)...);
+			}
+			catch (...)
+			{
+				CloseRecycledGap(1u);
+				throw;
 			}
 		}
+
+		return *m_pCurrentEnd++;
 	}
 
-	__NODISCARD constexpr uint64_t CalculateNewCapacity(const uint64_t min) const
+	/* After removing elements there are n raw slots between the end and the recycled objects,
+	   the last recycled objects get moved into them so the recycled objects stay right behind the end */
+	constexpr void CloseRecycledGap(const uint64_t n)
 	{
-		const uint64_t oldCap{ Capacity() };
-		const uint64_t maxCap{ MaxSize() };
+		const uint64_t nrToMove{ n < m_NrOfRecycled ? n : m_NrOfRecycled };
+		T* const pRecycledEnd{ m_pCurrentEnd + n + m_NrOfRecycled };
+
+		MoveRangeBackward(pRecycledEnd - nrToMove, pRecycledEnd, m_pCurrentEnd);
+	}
 
-		if (oldCap > maxCap - oldCap / 2u)
-			return maxCap;
+	constexpr void DestroyRecycled()
+	{
+		if (m_NrOfRecycled == 0u)
+			return;
 
-		const uint64_t newCap{ oldCap + oldCap / 2u };
+		DeleteData(m_pCurrentEnd, m_pCurrentEnd + m_NrOfRecycled);
+		m_NrOfRecycled = 0u;
+	}
+
+	/* Makes sure n more elements fit at the back, reallocating at most once.
+	   Recycled objects are left alone when there is room, so the caller has to use them up or destroy them before constructing there */
+	constexpr void ReserveForAppend(const uint64_t n)
+	{
+		if (static_cast<uint64_t>(m_pTail - m_pCurrentEnd) >= n)
+			return;
 
-		// If our growth is insufficient, return just the bare minimum
-		if (newCap < min)
-			return min;
+		DestroyRecycled();
 
-		return newCap;
+		if (m_pHead != m_pBuffer && ShouldSlide(n))
+			Slide((Capacity() - Size() - n) / 2u);
+		else
+			ReallocateExactly(CalculateNewCapacity(Size() + n));
 	}
 
-	constexpr void MoveRangeBackward(T* head, T* end, T* newHead) const
+	/* Makes sure n more elements fit at the front, the free room gets split between both ends */
+	constexpr void ReserveForPrepend(const uint64_t n)
 	{
-		const uint64_t size{ static_cast<uint64_t>(end - head) };
-		for (uint64_t i{}; i < size; ++i)
+		if (static_cast<uint64_t>(m_pHead - m_pBuffer) >= n)
+			return;
+
+		const uint64_t size{ Size() };
+
+		if (ShouldSlide(n))
+			Slide(n + (Capacity() - size - n) / 2u);
+		else
 		{
-			if constexpr (std::is_move_assignable_v<T>)
-				new (newHead + i) T{ __MOVE(*(head + i)) };
-			else
-				new (newHead + i) T{ *(head + i) };
+			const uint64_t newCap{ CalculateNewCapacity(size + n) };
+
+			ReallocateExactly(newCap, n + (newCap - size - n) / 2u);
 		}
 	}
 
-	constexpr void MoveRangeForward(T* head, T* end, T* newHead) const
+	constexpr void AppendRange(const T* pSource, uint64_t n)
 	{
-		const int64_t size{ static_cast<int64_t>(end - head) };
-		for (int64_t i{ size - 1 }; i >= 0; --i)
+		/* Recycled objects get assigned over first */
+		for (; n > 0u && m_NrOfRecycled > 0u; --n)
+			EmplaceRecycled(*pSource++);
+
+		if (n == 0u)
+			return;
+
+		/* The source might be part of ourselves, in which case it moves when we reallocate */
+		if (pSource >= m_pHead && pSource < m_pCurrentEnd)
 		{
-			if constexpr (std::is_move_assignable_v<T>)
-				new (newHead + i) T{ __MOVE(*(head + i)) };
-			else
-				new (newHead + i) T{ *(head + i) };
+			const uint64_t offset{ static_cast<uint64_t>(pSource - m_pHead) };
+			ReserveForAppend(n);
+			pSource = m_pHead + offset;
+		}
+		else
+			ReserveForAppend(n);
+
+		if constexpr (std::is_trivially_copyable_v<T>)
+		{
+			std::memcpy(static_cast<void*>(m_pCurrentEnd), static_cast<const void*>(pSource), n * sizeof(T));
+			m_pCurrentEnd += n;
+		}
+		else
+		{
+			/* The end moves along with every element, so the ones built before a throwing copy still get destroyed */
+			for (uint64_t i{}; i < n; ++i, ++m_pCurrentEnd)
+				AllocTraits::construct(m_Alloc, m_pCurrentEnd, *(pSource + i));
 		}
 	}
-#pragma endregion
 
-#pragma region Sorters
-	constexpr void InsertionSort(const BinaryPred& pred) const
+	constexpr void AppendFill(uint64_t n, const T& val)
 	{
-		/* Don't use At() to make sure elements get copied instead of referenced around! */
+		for (; n > 0u && m_NrOfRecycled > 0u; --n)
+			EmplaceRecycled(val);
 
-		const uint64_t size{ Size() };
-		for (int i{ 1 }; i < size; ++i)
-		{
-			T key = *(m_pHead + i);
-			int j{ i - 1 };
+		if (n == 0u)
+			return;
 
-			while (j >= 0 && pred(key, *(m_pHead + j)))
-			{
-				*(m_pHead + j + 1) = *(m_pHead + j);
-				--j;
-			}
+		const T* pVal{ &val };
 
-			*(m_pHead + j + 1) = key;
+		/* val might be one of our own elements, in which case it moves when we reallocate */
+		if (pVal >= m_pHead && pVal < m_pCurrentEnd)
+		{
+			const uint64_t offset{ static_cast<uint64_t>(pVal - m_pHead) };
+			ReserveForAppend(n);
+			pVal = m_pHead + offset;
 		}
+		else
+			ReserveForAppend(n);
+
+		for (uint64_t i{}; i < n; ++i, ++m_pCurrentEnd)
+			AllocTraits::construct(m_Alloc, m_pCurrentEnd, *pVal);
 	}
-	constexpr void MergeSort(const uint64_t begin, const uint64_t end, const BinaryPred& pred) const
+
+	constexpr void AppendDefault(uint64_t n)
 	{
-		/* Check recursion stop */
-		if (begin >= end)
+		for (; n > 0u && m_NrOfRecycled > 0u; --n)
+			EmplaceRecycled();
+
+		if (n == 0u)
 			return;
 
-		const uint64_t mid{ begin + (end - begin) / 2u };
+		ReserveForAppend(n);
 
-		MergeSort(begin, mid, pred);
-		MergeSort(mid + 1u, end, pred);
-		Merge(begin, mid, end, pred);
+		for (uint64_t i{}; i < n; ++i, ++m_pCurrentEnd)
+			AllocTraits::construct(m_Alloc, m_pCurrentEnd);
 	}
-	constexpr void Merge(uint64_t left, uint64_t mid, const uint64_t right, const BinaryPred& pred) const
+
+	/* Expects our pointers to be reset */
+	constexpr void CopyFrom(const Array& other)
 	{
-		uint64_t halfStart{ mid + 1u };
+		const uint64_t cap{ other.Capacity() };
+		const uint64_t size{ other.Size() };
 
-		if (pred(*(m_pHead + mid), *(m_pHead + halfStart)))
-			return;
+		if (cap > 0u && (InlineCapacity == 0 || size > InlineCapacity))
+		{
+			m_pBuffer = m_pHead = Allocate(cap);
+			m_pTail = m_pBuffer + cap;
+		}
 
-		while (left <= mid && halfStart <= right)
+		if constexpr (std::is_trivially_copyable_v<T>)
+		{
+			if (size > 0u)
+				std::memcpy(static_cast<void*>(m_pHead), static_cast<const void*>(other.m_pHead), size * sizeof(T));
+		}
+		else
 		{
-			if (pred(*(m_pHead + left), *(m_pHead + halfStart)))
-				++left;
+			for (uint64_t i{}; i < size; ++i)
+				AllocTraits::construct(m_Alloc, m_pHead + i, *(other.m_pHead + i)); // dont allow moving 
+		}
+
+		m_pCurrentEnd = m_pHead + size;
+	}
+
+	/* Copies other's elements into our block, which has to be big enough already.
+	   Our live elements get assigned over and only the surplus is constructed or destroyed */
+	constexpr void AssignFrom(const Array& other)
+	{
+		const uint64_t otherSize{ other.Size() };
+
+		if (otherSize > static_cast<uint64_t>(m_pTail - m_pHead))
+			Slide(0u);
+
+		if constexpr (std::is_trivially_copyable_v<T>)
+		{
+			if (otherSize > 0u)
+				std::memcpy(static_cast<void*>(m_pHead), static_cast<const void*>(other.m_pHead), otherSize * sizeof(T));
+		}
+		else
+		{
+			const uint64_t size{ Size() };
+			const uint64_t nrOfAssigned{ size < otherSize ? size : otherSize };
+
+			if constexpr (std::is_copy_assignable_v<T>)
+			{
+				for (uint64_t i{}; i < nrOfAssigned; ++i)
+					*(m_pHead + i) = *(other.m_pHead + i);
+			}
 			else
 			{
-				T val{ *(m_pHead + halfStart) };
-				uint64_t i{ halfStart };
-
-				while (i != left)
+				for (uint64_t i{}; i < nrOfAssigned; ++i)
 				{
-					*(m_pHead + i) = *(m_pHead + i - 1);
-					--i;
+					AllocTraits::destroy(m_Alloc, m_pHead + i);
+					AllocTraits::construct(m_Alloc, m_pHead + i, *(other.m_pHead + i));
 				}
+			}
+
+			for (uint64_t i{ nrOfAssigned }; i < otherSize; ++i)
+				AllocTraits::construct(m_Alloc, m_pHead + i, *(other.m_pHead + i));
+
+			DeleteData(m_pHead + otherSize, m_pCurrentEnd);
+		}
+
+		m_pCurrentEnd = m_pHead + otherSize;
+	}
+
+	/* Points us at our (possibly non-existent) inline buffer, does not free anything */
+	constexpr void ResetPointers()
+	{
+		m_pBuffer = InlineData();
+		m_pHead = InlineData();
+		m_pTail = InlineData() + InlineCapacity;
+		m_pCurrentEnd = InlineData();
+		m_NrOfRecycled = 0u;
+	}
 
-				*(m_pHead + left) = val;
+	__NODISCARD constexpr T* InlineData()
+	{
+		if constexpr (InlineCapacity > 0)
+			return reinterpret_cast<T*>(m_InlineBuffer.Buffer);
+		else
+			return nullptr;
+	}
+	__NODISCARD constexpr const T* InlineData() const
+	{
+		if constexpr (InlineCapacity > 0)
+			return reinterpret_cast<const T*>(m_InlineBuffer.Buffer);
+		else
+			return nullptr;
+	}
+
+	__NODISCARD constexpr bool IsInline() const
+	{
+		if constexpr (InlineCapacity > 0)
+			return m_pBuffer == InlineData();
+		else
+			return false;
+	}
 
-				++left;
-				++mid;
-				++halfStart;
+	constexpr void DeleteData(T* head, T* const tail)
+	{
+		if constexpr (!std::is_trivially_destructible_v<T>)
+		{
+			while (head < tail)
+			{
+				AllocTraits::destroy(m_Alloc, head);
+				++head;
 			}
 		}
 	}
+
+	__NODISCARD constexpr uint64_t CalculateNewCapacity(const uint64_t min) const
+	{
+		return GrowthPolicy::CalculateNewCapacity(Capacity(), min, sizeof(T));
+	}
+
+	/* Both MoveRange functions relocate [head, end) to newHead: every destination slot must be raw memory,
+	   and every source slot is raw memory afterwards */
+	constexpr void MoveRangeBackward(T* head, T* end, T* newHead)
+	{
+		const uint64_t size{ static_cast<uint64_t>(end - head) };
+
+		if constexpr (IsTriviallyRelocatable_v<T>)
+		{
+			if (size > 0u)
+				std::memmove(static_cast<void*>(newHead), static_cast<const void*>(head), size * sizeof(T));
+
+			return;
+		}
+
+		for (uint64_t i{}; i < size; ++i)
+		{
+			if constexpr (std::is_move_assignable_v<T>)
+				AllocTraits::construct(m_Alloc, newHead + i, __MOVE(*(head + i)));
+			else
+				AllocTraits::construct(m_Alloc, newHead + i, *(head + i));
+
+			AllocTraits::destroy(m_Alloc, head + i);
+		}
+	}
+
+	constexpr void MoveRangeForward(T* head, T* end, T* newHead)
+	{
+		const int64_t size{ static_cast<int64_t>(end - head) };
+
+		if constexpr (IsTriviallyRelocatable_v<T>)
+		{
+			if (size > 0)
+				std::memmove(static_cast<void*>(newHead), static_cast<const void*>(head), static_cast<uint64_t>(size) * sizeof(T));
+
+			return;
+		}
+
+		for (int64_t i{ size - 1 }; i >= 0; --i)
+		{
+			if constexpr (std::is_move_assignable_v<T>)
+				AllocTraits::construct(m_Alloc, newHead + i, __MOVE(*(head + i)));
+			else
+				AllocTraits::construct(m_Alloc, newHead + i, *(head + i));
+
+			AllocTraits::destroy(m_Alloc, head + i);
+		}
+	}
 #pragma endregion
 
+	T* m_pBuffer; /* Start of our block, the elements start at m_pHead */
 	T* m_pHead;
 	T* m_pTail;
 	T* m_pCurrentEnd /* points PAST the last element */;
+	uint64_t m_NrOfRecycled; /* Constructed objects kept alive after m_pCurrentEnd by ResetKeepObjects() */
+	__NO_UNIQUE_ADDRESS Alloc m_Alloc;
+
+	struct InlineStorage final
+	{
+		alignas(T) unsigned char Buffer[InlineCapacity * sizeof(T)];
+	};
+	struct NoInlineStorage final {};
+
+	__NO_UNIQUE_ADDRESS std::conditional_t<(InlineCapacity > 0), InlineStorage, NoInlineStorage> m_InlineBuffer;
 };
+
+/* Array whose memory comes from a std::pmr::memory_resource chosen at runtime */
+template<typename T>
+using PmrArray = Array<T, std::pmr::polymorphic_allocator<T>>;
+
+/* Array that keeps up to N elements inside the object and only goes to the heap when it grows beyond that */
+template<typename T, uint64_t N, typename Alloc = std::allocator<T>, typename GrowthPolicy = OneAndAHalfGrowth>
+using SmallArray = Array<T, Alloc, GrowthPolicy, N>;
+
+/* Array whose Data() is aligned to Alignment bytes, also after it reallocated or had elements added or removed anywhere.
+   To keep it that way the elements always start at the start of the block, so the front operations are O(n) here */
+template<typename T, uint64_t Alignment, typename GrowthPolicy = OneAndAHalfGrowth>
+using AlignedArray = Array<T, AlignedAllocator<T, Alignment>, GrowthPolicy>;
@@ -0,0 +1,111 @@
+#pragma once
+
+#include "Utils.h"
+
+#include <stdint.h>
+#include <limits> /* std::numeric_limits */
+
+/* A growth policy decides the new capacity of an Array that needs room for at least minCap elements.
+   Every policy has the same signature: static uint64_t CalculateNewCapacity(oldCap, minCap, elemSize) */
+
+/* oldCap + oldCap * num / den, clamped to the maximum capacity instead of overflowing */
+__NODISCARD __INLINE constexpr uint64_t GrowCapacity(const uint64_t oldCap, const uint64_t num, const uint64_t den)
+{
+	constexpr uint64_t maxCap{ std::numeric_limits<uint64_t>::max() };
+
+	const uint64_t extra{ oldCap / den * num + oldCap % den * num / den };
+
+	if (oldCap > maxCap - extra)
+		return maxCap;
+
+	return oldCap + extra;
+}
+
+__NODISCARD __INLINE constexpr uint64_t RoundUpToMultiple(const uint64_t val, const uint64_t multiple)
+{
+	return (val + multiple - 1u) / multiple * multiple;
+}
+
+struct OneAndAHalfGrowth final
+{
+	__NODISCARD static constexpr uint64_t CalculateNewCapacity(const uint64_t oldCap, const uint64_t minCap, const uint64_t)
+	{
+		const uint64_t newCap{ GrowCapacity(oldCap, 1u, 2u) };
+
+		// If our growth is insufficient, return just the bare minimum
+		return newCap < minCap ? minCap : newCap;
+	}
+};
+
+struct DoubleGrowth final
+{
+	__NODISCARD static constexpr uint64_t CalculateNewCapacity(const uint64_t oldCap, const uint64_t minCap, const uint64_t)
+	{
+		const uint64_t newCap{ GrowCapacity(oldCap, 1u, 1u) };
+
+		return newCap < minCap ? minCap : newCap;
+	}
+};
+
+/* Grows by ~1.618x, in between OneAndAHalfGrowth and DoubleGrowth in both reallocation count and slack */
+struct GoldenRatioGrowth final
+{
+	__NODISCARD static constexpr uint64_t CalculateNewCapacity(const uint64_t oldCap, const uint64_t minCap, const uint64_t)
+	{
+		const uint64_t newCap{ GrowCapacity(oldCap, 618u, 1000u) };
+
+		return newCap < minCap ? minCap : newCap;
+	}
+};
+
+/* Grows by 1.5x, but once the block is at least a page big it is rounded up to a whole number of pages,
+   so the memory the OS maps in for us is never left unused */
+template<uint64_t PageSize = 4096u>
+struct PageRoundedGrowth final
+{
+	__NODISCARD static constexpr uint64_t CalculateNewCapacity(const uint64_t oldCap, const uint64_t minCap, const uint64_t elemSize)
+	{
+		const uint64_t newCap{ OneAndAHalfGrowth::CalculateNewCapacity(oldCap, minCap, elemSize) };
+
+		if (newCap * elemSize < PageSize || newCap > std::numeric_limits<uint64_t>::max() / elemSize - PageSize)
+			return newCap;
+
+		return RoundUpToMultiple(newCap * elemSize, PageSize) / elemSize;
+	}
+};
+
+/* Approximation of the block sizes malloc really hands out for a request of n bytes */
+struct MallocSizeClasses final
+{
+	__NODISCARD static constexpr uint64_t RoundUp(const uint64_t bytes)
+	{
+#ifdef _WIN32
+		/* The CRT heap hands out blocks in 16 byte granules */
+		return RoundUpToMultiple(bytes, 16u);
+#else
+		/* glibc: blocks of 128 KiB and up are mmapped with a 16 byte header,
+		   smaller blocks are 16 byte aligned chunks with an 8 byte header and a 32 byte minimum */
+		if (bytes >= 128u * 1024u)
+			return RoundUpToMultiple(bytes + 16u, 4096u) - 16u;
+
+		const uint64_t chunk{ RoundUpToMultiple(bytes + 8u, 16u) };
+
+		return (chunk < 32u ? 32u : chunk) - 8u;
+#endif
+	}
+};
+
+/* Grows by 1.5x and then claims whatever slack the allocator would have given us anyway */
+template<typename SizeClasses = MallocSizeClasses>
+struct SizeClassGrowth final
+{
+	__NODISCARD static constexpr uint64_t CalculateNewCapacity(const uint64_t oldCap, const uint64_t minCap, const uint64_t elemSize)
+	{
+		const uint64_t newCap{ OneAndAHalfGrowth::CalculateNewCapacity(oldCap, minCap, elemSize) };
+
+		if (newCap > std::numeric_limits<uint64_t>::max() / elemSize - 8192u)
+			return newCap;
+
+		return SizeClasses::RoundUp(newCap * elemSize) / elemSize;
+	}
+};
@@ -0,0 +1,594 @@
+#pragma once
+
+#include "Utils.h"
+#include "Types.h"
+#include "Iterator.h"
+#include "Sorting.h"
+
+#include <cstring> /* std::memmove */
+#include <functional> /* std::function */
+#include <memory> /* std::construct_at, std::destroy_at */
+#include <new> /* std::launder, std::bad_alloc */
+
+/* Array with a fixed capacity of N elements stored inside the object, it never allocates.
+   Running out of capacity throws std::bad_alloc (like std::inplace_vector), also in release builds. Use the Try functions to handle it instead.
+   When T is trivial the InplaceArray can be used in constexpr contexts, and it is trivially copyable when T is */
+template<typename T, uint64_t N>
+class InplaceArray final
+{
+	using UnaryPred = std::function<bool(const T&)>;
+	using BinaryPred = std::function<bool(const T&, const T&)>;
+
+	static_assert(N > 0, "InplaceArray<T, N> > N must be larger than 0!");
+
+public:
+	using It = Iterator<T>;
+	using CIt = ConstIterator<T>;
+
+#pragma region Ctors and Dtor
+	constexpr InplaceArray()
+		: m_Size{}
+	{}
+	constexpr InplaceArray(const Size_P size)
+		: m_Size{}
+	{
+		CheckCapacity(size._Size);
+
+		for (uint64_t i{}; i < size._Size; ++i)
+			EmplaceBack();
+	}
+	constexpr InplaceArray(const Size_P size, const T& val)
+		: m_Size{}
+	{
+		CheckCapacity(size._Size);
+
+		for (uint64_t i{}; i < size._Size; ++i)
+			EmplaceBack(val);
+	}
+	constexpr InplaceArray(std::initializer_list<T> init)
+		: m_Size{}
+	{
+		AddRange(init);
+	}
+	constexpr InplaceArray(It beg, It end)
+		: m_Size{}
+	{
+		AddRange(beg, end);
+	}
+
+	constexpr ~InplaceArray() requires std::is_trivially_destructible_v<T> = default;
+	constexpr ~InplaceArray()
+	{
+		Clear();
+	}
+#pragma endregion
+
+#pragma region Rule of 5
+	/* Every special member is trivial when T's is, so an InplaceArray of a trivially copyable T is trivially copyable */
+	constexpr InplaceArray(const InplaceArray&) requires std::is_trivially_copy_constructible_v<T> = default;
+	constexpr InplaceArray(const InplaceArray& other)
+		: m_Size{}
+	{
+		for (uint64_t i{}; i < other.m_Size; ++i)
+			EmplaceBack(other[i]);
+	}
+	constexpr InplaceArray(InplaceArray&&) noexcept requires std::is_trivially_move_constructible_v<T> = default;
+	constexpr InplaceArray(InplaceArray&& other) noexcept
+		: m_Size{}
+	{
+		for (uint64_t i{}; i < other.m_Size; ++i)
+			EmplaceBack(__MOVE(other[i]));
+
+		other.Clear();
+	}
+
+	constexpr InplaceArray& operator=(const InplaceArray&) requires std::is_trivially_copy_assignable_v<T>
+		&& std::is_trivially_copy_constructible_v<T> && std::is_trivially_destructible_v<T> = default;
+	constexpr InplaceArray& operator=(const InplaceArray& other)
+	{
+		if (this == &other)
+			return *this;
+
+		Clear();
+
+		for (uint64_t i{}; i < other.m_Size; ++i)
+			EmplaceBack(other[i]);
+
+		return *this;
+	}
+	constexpr InplaceArray& operator=(InplaceArray&&) noexcept requires std::is_trivially_move_assignable_v<T>
+		&& std::is_trivially_move_constructible_v<T> && std::is_trivially_destructible_v<T> = default;
+	constexpr InplaceArray& operator=(InplaceArray&& other) noexcept
+	{
+		if (this == &other)
+			return *this;
+
+		Clear();
+
+		for (uint64_t i{}; i < other.m_Size; ++i)
+			EmplaceBack(__MOVE(other[i]));
+
+		other.Clear();
+
+		return *this;
+	}
+#pragma endregion
+
+#pragma region Adding and Removing Elements
+	constexpr void Add(const T& val)
+	{
+		EmplaceBack(val);
+	}
+	constexpr void Add(T&& val)
+	{
+		EmplaceBack(__MOVE(val));
+	}
+
+	/* Returns false instead of adding when the InplaceArray is full */
+	__NODISCARD constexpr bool TryAdd(const T& val)
+	{
+		return TryEmplaceBack(val) != nullptr;
+	}
+	__NODISCARD constexpr bool TryAdd(T&& val)
+	{
+		return TryEmplaceBack(__MOVE(val)) != nullptr;
+	}
+
+	constexpr void AddFront(const T& val)
+	{
+		EmplaceFront(val);
+	}
+	constexpr void AddFront(T&& val)
+	{
+		EmplaceFront(__MOVE(val));
+	}
+
+	constexpr void AddRange(std::initializer_list<T> elems)
+	{
+		CheckCapacity(m_Size + elems.size());
+
+		for (const T& elem : elems)
+			EmplaceBack(elem);
+	}
+	constexpr void AddRange(It beg, It end)
+	{
+		__ASSERT(beg <= end && "InplaceArray::AddRange() > beg cannot be past end");
+
+		CheckCapacity(m_Size + static_cast<uint64_t>(end - beg));
+
+		for (; beg != end; ++beg)
+			EmplaceBack(*beg);
+	}
+	constexpr void AddRange(const T* pArr, const uint64_t n)
+	{
+		__ASSERT(pArr != nullptr);
+
+		CheckCapacity(m_Size + n);
+
+		for (uint64_t i{}; i < n; ++i)
+			EmplaceBack(pArr[i]);
+	}
+
+	constexpr It EraseByIndex(const uint64_t index)
+	{
+		__ASSERT(index < m_Size && "InplaceArray::EraseByIndex() > index is out of range");
+
+		std::destroy_at(Data() + index);
+		MoveRangeBackward(Data() + index + 1, Data() + m_Size, Data() + index);
+		--m_Size;
+
+		return It{ Data() + index };
+	}
+
+	constexpr It Erase(It pos)
+	{
+		__ASSERT(pos != end() && "InplaceArray::Erase() > invalid iterator was passed as a parameter");
+
+		return EraseByIndex(static_cast<uint64_t>(&*pos - Data()));
+	}
+	constexpr It Erase(const T& val)
+	{
+		for (uint64_t i{}; i < m_Size; ++i)
+			if (*(Data() + i) == val)
+				return EraseByIndex(i);
+
+		return end();
+	}
+	constexpr It Erase(const UnaryPred& pred)
+	{
+		for (uint64_t i{}; i < m_Size; ++i)
+			if (pred(*(Data() + i)))
+				return EraseByIndex(i);
+
+		return end();
+	}
+
+	constexpr void EraseRange(const uint64_t start, uint64_t count)
+	{
+		__ASSERT(start < m_Size && "InplaceArray::EraseRange() > Start is out of range");
+
+		if (count > m_Size - start)
+			count = m_Size - start;
+
+		for (uint64_t i{}; i < count; ++i)
+			std::destroy_at(Data() + start + i);
+
+		MoveRangeBackward(Data() + start + count, Data() + m_Size, Data() + start);
+		m_Size -= count;
+	}
+
+	constexpr void Insert(const uint64_t index, const T& val)
+	{
+		Emplace(index, val);
+	}
+	constexpr void Insert(const uint64_t index, T&& val)
+	{
+		Emplace(index, __MOVE(val));
+	}
+
+	constexpr void Pop()
+	{
+		if (m_Size == 0)
+			return;
+
+		std::destroy_at(Data() + --m_Size);
+	}
+
+	constexpr void PopFront()
+	{
+		if (m_Size == 0)
+			return;
+
+		EraseByIndex(0);
+	}
+
+	constexpr void Clear()
+	{
+		if constexpr (!std::is_trivially_destructible_v<T>)
+			for (uint64_t i{}; i < m_Size; ++i)
+				std::destroy_at(Data() + i);
+
+		m_Size = 0;
+	}
+
+	template<typename ... Ts>
+	constexpr T& EmplaceBack(Ts&&... args)
+	{
+		CheckCapacity(m_Size + 1u);
+
+		T* const pElem{ std::construct_at(Data() + m_Size, __FORWARD(args)...) };
+		++m_Size;
+
+		return *pElem;
+	}
+
+	/* Returns nullptr instead of emplacing when the InplaceArray is full */
+	template<typename ... Ts>
+	__NODISCARD constexpr T* TryEmplaceBack(Ts&&... args)
+	{
+		if (m_Size == N)
+			return nullptr;
+
+		T* const pElem{ std::construct_at(Data() + m_Size, __FORWARD(args)...) };
+		++m_Size;
+
+		return pElem;
+	}
+
+	template<typename ... Ts>
+	constexpr T& Emplace(const uint64_t index, Ts&&... args)
+	{
+		__ASSERT(index <= m_Size && "InplaceArray::Emplace() > index is out of range");
+
+		if (index == m_Size)
+			return EmplaceBack(__FORWARD(args)...);
+
+		CheckCapacity(m_Size + 1u);
+
+		/* Built before shifting, the arguments might refer to one of our own elements */
+		T val(__FORWARD(args)...);
+
+		MoveRangeForward(Data() + index, Data() + m_Size, Data() + index + 1);
+
+		try
+		{
+			std::construct_at(Data() + index, __MOVE(val));
+		}
+		catch (...)
+		{
+			MoveRangeBackward(Data() + index + 1, Data() + m_Size + 1, Data() + index);
+			throw;
+		}
+
+		++m_Size;
+
+		return *(Data() + index);
+	}
+
+	template<typename ... Ts>
+	constexpr T& EmplaceFront(Ts&&... args)
+	{
+		return Emplace(0, __FORWARD(args)...);
+	}
+#pragma endregion
+
+#pragma region Array Information
+	__NODISCARD constexpr bool Empty() const
+	{
+		return m_Size == 0;
+	}
+
+	__NODISCARD constexpr bool Full() const
+	{
+		return m_Size == N;
+	}
+
+	__NODISCARD constexpr uint64_t Size() const
+	{
+		return m_Size;
+	}
+
+	__NODISCARD constexpr uint64_t Capacity() const
+	{
+		return N;
+	}
+
+	__NODISCARD constexpr uint64_t MaxSize() const
+	{
+		return N;
+	}
+
+	__NODISCARD constexpr bool operator==(const InplaceArray& other) const
+	{
+		if (m_Size != other.m_Size)
+			return false;
+
+		for (uint64_t i{}; i < m_Size; ++i)
+			if (*(Data() + i) != *(other.Data() + i))
+				return false;
+
+		return true;
+	}
+
+	__NODISCARD constexpr bool operator!=(const InplaceArray& other) const
+	{
+		return !(*this == other);
+	}
+#pragma endregion
+
+#pragma region Manipulating Array
+	constexpr void Resize(const uint64_t newSize)
+	{
+		static_assert(std::is_default_constructible_v<T>, "InplaceArray::Resize() > T is not default constructable!");
+
+		Resize(newSize, T{});
+	}
+	constexpr void Resize(const uint64_t newSize, const T& val)
+	{
+		CheckCapacity(newSize);
+
+		while (m_Size < newSize)
+			EmplaceBack(val);
+
+		while (m_Size > newSize)
+			Pop();
+	}
+
+	constexpr InplaceArray Select(const UnaryPred& pred) const
+	{
+		InplaceArray arr{};
+
+		for (uint64_t i{}; i < m_Size; ++i)
+			if (pred(*(Data() + i)))
+				arr.Add(*(Data() + i));
+
+		return arr;
+	}
+
+	constexpr void Sort()
+	{
+		StableSort(Data(), m_Size, [](const T& a, const T& b)->bool
+			{
+				return a < b;
+			});
+	}
+	constexpr void Sort(const BinaryPred& pred)
+	{
+		StableSort(Data(), m_Size, pred);
+	}
+#pragma endregion
+
+#pragma region Accessing Elements
+	constexpr T& Front()
+	{
+		__ASSERT(m_Size > 0 && "InplaceArray::Front() > InplaceArray is empty");
+
+		return *Data();
+	}
+	constexpr const T& Front() const
+	{
+		__ASSERT(m_Size > 0 && "InplaceArray::Front() > InplaceArray is empty");
+
+		return *Data();
+	}
+
+	constexpr T& Back()
+	{
+		__ASSERT(m_Size > 0 && "InplaceArray::Back() > InplaceArray is empty");
+
+		return *(Data() + m_Size - 1);
+	}
+	constexpr const T& Back() const
+	{
+		__ASSERT(m_Size > 0 && "InplaceArray::Back() > InplaceArray is empty");
+
+		return *(Data() + m_Size - 1);
+	}
+
+	constexpr T& At(const uint64_t index)
+	{
+		__ASSERT((index < m_Size) && "InplaceArray::At() > Index is out of range");
+
+		return *(Data() + index);
+	}
+	constexpr const T& At(const uint64_t index) const
+	{
+		__ASSERT((index < m_Size) && "InplaceArray::At() > Index is out of range");
+
+		return *(Data() + index);
+	}
+
+	constexpr T& operator[](const uint64_t index)
+	{
+		return *(Data() + index);
+	}
+	constexpr const T& operator[](const uint64_t index) const
+	{
+		return *(Data() + index);
+	}
+
+	constexpr T* Data()
+	{
+		if constexpr (IsTrivialStorage)
+			return m_Storage.Data;
+		else
+			return std::launder(reinterpret_cast<T*>(m_Storage.Buffer));
+	}
+	constexpr const T* Data() const
+	{
+		if constexpr (IsTrivialStorage)
+			return m_Storage.Data;
+		else
+			return std::launder(reinterpret_cast<const T*>(m_Storage.Buffer));
+	}
+
+	constexpr It Find(const T& val)
+	{
+		for (uint64_t i{}; i < m_Size; ++i)
+			if (*(Data() + i) == val)
+				return It{ Data() + i };
+
+		return end();
+	}
+	constexpr CIt Find(const T& val) const
+	{
+		for (uint64_t i{}; i < m_Size; ++i)
+			if (*(Data() + i) == val)
+				return CIt{ Data() + i };
+
+		return end();
+	}
+	constexpr It Find(const UnaryPred& pred)
+	{
+		for (uint64_t i{}; i < m_Size; ++i)
+			if (pred(*(Data() + i)))
+				return It{ Data() + i };
+
+		return end();
+	}
+	constexpr CIt Find(const UnaryPred& pred) const
+	{
+		for (uint64_t i{}; i < m_Size; ++i)
+			if (pred(*(Data() + i)))
+				return CIt{ Data() + i };
+
+		return end();
+	}
+
+	constexpr InplaceArray FindAll(const T& val) const
+	{
+		InplaceArray arr{};
+
+		for (uint64_t i{}; i < m_Size; ++i)
+			if (*(Data() + i) == val)
+				arr.EmplaceBack(*(Data() + i));
+
+		return arr;
+	}
+	constexpr InplaceArray FindAll(const UnaryPred& pred) const
+	{
+		return Select(pred);
+	}
+#pragma endregion
+
+#pragma region Iterators
+	constexpr It begin() { return Data(); }
+	constexpr CIt begin() const { return Data(); }
+
+	constexpr It end() { return Data() + m_Size; }
+	constexpr CIt end() const { return Data() + m_Size; }
+
+	constexpr CIt cbegin() const { return Data(); }
+	constexpr CIt cend() const { return Data() + m_Size; }
+#pragma endregion
+
+private:
+	/* Trivial types live in a real array so they can be used in constant expressions */
+	static constexpr bool IsTrivialStorage{ std::is_trivial_v<T> };
+
+#pragma region Internal Helpers
+	constexpr void CheckCapacity(const uint64_t newSize) const
+	{
+		if (newSize > N)
+			throw std::bad_alloc{};
+	}
+
+	/* Both MoveRange functions relocate [head, end) to newHead: every destination slot must be free,
+	   and every source slot is free afterwards */
+	constexpr void MoveRangeBackward(T* head, T* end, T* newHead)
+	{
+		const uint64_t size{ static_cast<uint64_t>(end - head) };
+
+		if constexpr (IsTriviallyRelocatable_v<T>)
+		{
+			if (!std::is_constant_evaluated())
+			{
+				if (size > 0u)
+					std::memmove(static_cast<void*>(newHead), static_cast<const void*>(head), size * sizeof(T));
+
+				return;
+			}
+		}
+
+		for (uint64_t i{}; i < size; ++i)
+		{
+			std::construct_at(newHead + i, __MOVE(*(head + i)));
+			std::destroy_at(head + i);
+		}
+	}
+
+	constexpr void MoveRangeForward(T* head, T* end, T* newHead)
+	{
+		const int64_t size{ static_cast<int64_t>(end - head) };
+
+		if constexpr (IsTriviallyRelocatable_v<T>)
+		{
+			if (!std::is_constant_evaluated())
+			{
+				if (size > 0)
+					std::memmove(static_cast<void*>(newHead), static_cast<const void*>(head), static_cast<uint64_t>(size) * sizeof(T));
+
+				return;
+			}
+		}
+
+		for (int64_t i{ size - 1 }; i >= 0; --i)
+		{
+			std::construct_at(newHead + i, __MOVE(*(head + i)));
+			std::destroy_at(head + i);
+		}
+	}
+#pragma endregion
+
+	struct TrivialStorage final
+	{
+		T Data[N];
+	};
+	struct RawStorage final
+	{
+		alignas(T) unsigned char Buffer[N * sizeof(T)];
+	};
+
+	std::conditional_t<IsTrivialStorage, TrivialStorage, RawStorage> m_Storage;
+	uint64_t m_Size;
+};
@@ -0,0 +1,211 @@
+#pragma once
+
+#include "Utils.h"
+
+#include <stdint.h>
+#include <bit> /* std::bit_width */
+#include <mutex> /* std::mutex, std::lock_guard */
+#include <new> /* ::operator new, __STDCPP_DEFAULT_NEW_ALIGNMENT__ */
+#include <type_traits> /* std::true_type */
+
+/* Process-wide pool of power-of-two sized buffers.
+   Freed buffers go to a per-thread cache first and spill over to a central, mutex-protected free list per size class,
+   so the grow/shrink/destroy churn of Arrays is served from recycled buffers instead of the system allocator.
+   Requests larger than the biggest size class go straight to operator new */
+class BufferPool final
+{
+public:
+	static constexpr uint64_t MinBlockShift{ 4u }; /* 16 bytes */
+	static constexpr uint64_t MaxBlockShift{ 20u }; /* 1 MiB */
+	static constexpr uint64_t NrOfSizeClasses{ MaxBlockShift - MinBlockShift + 1u };
+
+	/* Amount of blocks moved between a thread cache and the central list at once */
+	static constexpr uint64_t BatchSize{ 16u };
+
+	__NODISCARD static BufferPool& GetInstance()
+	{
+		static BufferPool pool{};
+		return pool;
+	}
+
+	/* The amount of bytes a request of bytes really gets, so SizeClassGrowth<BufferPool> can use the slack */
+	__NODISCARD static constexpr uint64_t RoundUp(const uint64_t bytes)
+	{
+		if (bytes > (1ull << MaxBlockShift))
+			return bytes;
+
+		return 1ull << (MinBlockShift + GetSizeClass(bytes));
+	}
+
+	__NODISCARD void* Allocate(const uint64_t bytes)
+	{
+		if (bytes > (1ull << MaxBlockShift))
+			return ::operator new(bytes);
+
+		const uint64_t sizeClass{ GetSizeClass(bytes) };
+		ThreadCache& cache{ GetThreadCache() };
+
+		if (!cache.pHeads[sizeClass])
+			FetchFromCentral(cache, sizeClass);
+
+		if (FreeBlock* const pBlock{ cache.pHeads[sizeClass] })
+		{
+			cache.pHeads[sizeClass] = pBlock->pNext;
+			--cache.Counts[sizeClass];
+
+			return pBlock;
+		}
+
+		return ::operator new(1ull << (MinBlockShift + sizeClass));
+	}
+
+	void Deallocate(void* const pData, const uint64_t bytes)
+	{
+		if (bytes > (1ull << MaxBlockShift))
+		{
+			::operator delete(pData);
+			return;
+		}
+
+		const uint64_t sizeClass{ GetSizeClass(bytes) };
+		ThreadCache& cache{ GetThreadCache() };
+
+		FreeBlock* const pBlock{ static_cast<FreeBlock*>(pData) };
+		pBlock->pNext = cache.pHeads[sizeClass];
+		cache.pHeads[sizeClass] = pBlock;
+
+		if (++cache.Counts[sizeClass] > GetMaxCachedBlocks(sizeClass))
+			ReturnToCentral(cache, sizeClass, cache.Counts[sizeClass] / 2u);
+	}
+
+private:
+	struct FreeBlock final
+	{
+		FreeBlock* pNext;
+	};
+
+	struct CentralList final
+	{
+		std::mutex Mutex;
+		FreeBlock* pHead{};
+	};
+
+	struct ThreadCache final
+	{
+		ThreadCache() = default;
+		~ThreadCache()
+		{
+			/* Hand everything to the central lists so other threads can reuse it */
+			for (uint64_t i{}; i < NrOfSizeClasses; ++i)
+				BufferPool::GetInstance().ReturnToCentral(*this, i, Counts[i]);
+		}
+
+		ThreadCache(const ThreadCache&) noexcept = delete;
+		ThreadCache(ThreadCache&&) noexcept = delete;
+		ThreadCache& operator=(const ThreadCache&) noexcept = delete;
+		ThreadCache& operator=(ThreadCache&&) noexcept = delete;
+
+		FreeBlock* pHeads[NrOfSizeClasses]{};
+		uint64_t Counts[NrOfSizeClasses]{};
+	};
+
+	BufferPool() = default;
+	~BufferPool()
+	{
+		for (CentralList& list : m_CentralLists)
+		{
+			while (list.pHead)
+			{
+				FreeBlock* const pNext{ list.pHead->pNext };
+				::operator delete(list.pHead);
+				list.pHead = pNext;
+			}
+		}
+	}
+
+	__NODISCARD static constexpr uint64_t GetSizeClass(const uint64_t bytes)
+	{
+		const uint64_t shift{ static_cast<uint64_t>(std::bit_width(bytes > 1u ? bytes - 1u : 1u)) };
+
+		return shift <= MinBlockShift ? 0u : shift - MinBlockShift;
+	}
+
+	/* Every thread keeps at most 256 KiB (and at most 64 blocks) per size class */
+	__NODISCARD static constexpr uint64_t GetMaxCachedBlocks(const uint64_t sizeClass)
+	{
+		const uint64_t nrOfBlocks{ (256ull * 1024ull) >> (MinBlockShift + sizeClass) };
+
+		return nrOfBlocks < 1u ? 1u : (nrOfBlocks > 64u ? 64u : nrOfBlocks);
+	}
+
+	__NODISCARD static ThreadCache& GetThreadCache()
+	{
+		/* Make sure the pool outlives every thread cache */
+		(void)GetInstance();
+
+		thread_local ThreadCache cache{};
+		return cache;
+	}
+
+	void FetchFromCentral(ThreadCache& cache, const uint64_t sizeClass)
+	{
+		CentralList& list{ m_CentralLists[sizeClass] };
+		const std::lock_guard<std::mutex> lock{ list.Mutex };
+
+		for (uint64_t i{}; i < BatchSize && list.pHead; ++i)
+		{
+			FreeBlock* const pBlock{ list.pHead };
+			list.pHead = pBlock->pNext;
+
+			pBlock->pNext = cache.pHeads[sizeClass];
+			cache.pHeads[sizeClass] = pBlock;
+			++cache.Counts[sizeClass];
+		}
+	}
+
+	void ReturnToCentral(ThreadCache& cache, const uint64_t sizeClass, uint64_t nrOfBlocks)
+	{
+		CentralList& list{ m_CentralLists[sizeClass] };
+		const std::lock_guard<std::mutex> lock{ list.Mutex };
+
+		for (; nrOfBlocks > 0u && cache.pHeads[sizeClass]; --nrOfBlocks)
+		{
+			FreeBlock* const pBlock{ cache.pHeads[sizeClass] };
+			cache.pHeads[sizeClass] = pBlock->pNext;
+			--cache.Counts[sizeClass];
+
+			pBlock->pNext = list.pHead;
+			list.pHead = pBlock;
+		}
+	}
+
+	CentralList m_CentralLists[NrOfSizeClasses];
+};
+
+/* Allocator handing out recycled buffers from the BufferPool */
+template<typename T>
+class PoolAllocator final
+{
+	static_assert(alignof(T) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__, "PoolAllocator<T> > T is over-aligned!");
+
+public:
+	using value_type = T;
+	using is_always_equal = std::true_type;
+
+	constexpr PoolAllocator() = default;
+	template<typename U>
+	constexpr PoolAllocator(const PoolAllocator<U>&) {}
+
+	__NODISCARD T* allocate(const size_t n)
+	{
+		return static_cast<T*>(BufferPool::GetInstance().Allocate(n * sizeof(T)));
+	}
+
+	void deallocate(T* const pData, const size_t n)
+	{
+		BufferPool::GetInstance().Deallocate(pData, n * sizeof(T));
+	}
+
+	constexpr bool operator==(const PoolAllocator&) const { return true; }
+	constexpr bool operator!=(const PoolAllocator&) const { return false; }
+};
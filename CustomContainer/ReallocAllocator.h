@@ -0,0 +1,146 @@
+#pragma once
+
+#include "Utils.h"
+
+#include <stdint.h>
+#include <cstdlib> /* std::malloc, std::realloc, std::free */
+#include <cstring> /* std::memcpy */
+#include <new> /* std::bad_alloc */
+
+#ifdef __linux__
+#include <sys/mman.h> /* mmap, mremap, munmap */
+#include <unistd.h> /* sysconf */
+#endif
+
+/* Allocator that can grow a block in place instead of allocating a new one and copying.
+   Medium blocks go through realloc, blocks of at least MmapThreshold bytes get their own mapping
+   which mremap can grow by remapping pages instead of copying them (Linux only, other platforms use realloc).
+   Array only uses reallocate() for IsTriviallyRelocatable types, since the bytes are moved without a move constructor */
+template<typename T>
+class ReallocAllocator final
+{
+public:
+	using value_type = T;
+
+	static constexpr uint64_t MmapThreshold{ 32ull * 1024ull * 1024ull };
+
+	constexpr ReallocAllocator() = default;
+	template<typename U>
+	constexpr ReallocAllocator(const ReallocAllocator<U>&) {}
+
+	__NODISCARD T* allocate(const size_t n)
+	{
+		const uint64_t bytes{ n * sizeof(T) };
+
+		/* malloc(0) may return nullptr, which is not a failure */
+		if (bytes == 0u)
+			return nullptr;
+
+#ifdef __linux__
+		if (bytes >= MmapThreshold)
+			return static_cast<T*>(Map(bytes));
+#endif
+
+		void* const pData{ std::malloc(bytes) };
+
+		if (!pData)
+			throw std::bad_alloc{};
+
+		return static_cast<T*>(pData);
+	}
+
+	void deallocate(T* const pData, const size_t n)
+	{
+		if (!pData)
+			return;
+
+#ifdef __linux__
+		const uint64_t bytes{ n * sizeof(T) };
+
+		if (bytes >= MmapThreshold)
+		{
+			munmap(pData, RoundToPage(bytes));
+			return;
+		}
+#else
+		(void)n;
+#endif
+
+		std::free(pData);
+	}
+
+	/* Returns a block of newN elements holding the first min(oldN, newN) elements of pData, pData is invalid afterwards.
+	   Reallocating to 0 elements frees pData and returns nullptr */
+	__NODISCARD T* reallocate(T* const pData, const size_t oldN, const size_t newN)
+	{
+		const uint64_t oldBytes{ oldN * sizeof(T) };
+		const uint64_t newBytes{ newN * sizeof(T) };
+
+		if (newBytes == 0u)
+		{
+			deallocate(pData, oldN);
+			return nullptr;
+		}
+
+		if (!pData)
+			return allocate(newN);
+
+#ifdef __linux__
+		const bool bWasMapped{ oldBytes >= MmapThreshold };
+		const bool bIsMapped{ newBytes >= MmapThreshold };
+
+		if (bWasMapped && bIsMapped)
+		{
+			void* const pNewData{ mremap(pData, RoundToPage(oldBytes), RoundToPage(newBytes), MREMAP_MAYMOVE) };
+
+			if (pNewData == MAP_FAILED)
+				throw std::bad_alloc{};
+
+			return static_cast<T*>(pNewData);
+		}
+		else if (bWasMapped || bIsMapped)
+		{
+			/* Crossing between the two backends, this happens at most twice in the lifetime of a growing Array */
+			T* const pNewData{ allocate(newN) };
+
+			std::memcpy(static_cast<void*>(pNewData), static_cast<const void*>(pData), oldBytes < newBytes ? oldBytes : newBytes);
+
+			deallocate(pData, oldN);
+
+			return pNewData;
+		}
+#else
+		(void)oldBytes;
+#endif
+
+		void* const pNewData{ std::realloc(pData, newBytes) };
+
+		if (!pNewData)
+			throw std::bad_alloc{};
+
+		return static_cast<T*>(pNewData);
+	}
+
+	constexpr bool operator==(const ReallocAllocator&) const { return true; }
+	constexpr bool operator!=(const ReallocAllocator&) const { return false; }
+
+private:
+#ifdef __linux__
+	__NODISCARD static uint64_t RoundToPage(const uint64_t bytes)
+	{
+		static const uint64_t pageSize{ static_cast<uint64_t>(sysconf(_SC_PAGESIZE)) };
+
+		return (bytes + pageSize - 1u) & ~(pageSize - 1u);
+	}
+
+	__NODISCARD static void* Map(const uint64_t bytes)
+	{
+		void* const pData{ mmap(nullptr, RoundToPage(bytes), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0) };
+
+		if (pData == MAP_FAILED)
+			throw std::bad_alloc{};
+
+		return pData;
+	}
+#endif
+};
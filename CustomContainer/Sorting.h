@@ -0,0 +1,1450 @@
+#pragma once
+
+#include "Utils.h"
+#include "ThreadPool.h"
+
+#include <stdint.h>
+#include <algorithm> /* std::make_heap, std::sort_heap, std::fill */
+#include <bit> /* std::bit_cast */
+#include <memory> /* std::allocator, std::allocator_traits, std::construct_at, std::destroy_at, std::uninitialized_move */
+#include <new> /* ::operator new, std::align_val_t */
+#include <type_traits> /* std::is_constant_evaluated, std::make_unsigned_t */
+#include <utility> /* std::swap, std::pair */
+#include <vector> /* std::vector */
+
+/* Sorting algorithms shared by the containers, they all sort the live elements [pData, pData + size) in place */
+
+enum class SortMode
+{
+	Merge, /* Buffered merge sort, the default */
+	Adaptive /* Run-detecting merge sort, close to linear on input that is already (nearly) sorted */
+};
+
+/* Below this amount of elements the merge sorts switch to insertion sort */
+inline constexpr uint64_t InsertionSortThreshold{ 32u };
+
+template<typename T, typename Pred>
+constexpr void InsertionSort(T* const pData, const uint64_t size, const Pred& pred)
+{
+	/* Don't use references to make sure elements get moved instead of referenced around! */
+
+	for (int64_t i{ 1 }; i < static_cast<int64_t>(size); ++i)
+	{
+		if (!pred(*(pData + i), *(pData + i - 1)))
+			continue;
+
+		T key{ __MOVE(*(pData + i)) };
+		int64_t j{ i - 1 };
+
+		while (j >= 0 && pred(key, *(pData + j)))
+		{
+			*(pData + j + 1) = __MOVE(*(pData + j));
+			--j;
+		}
+
+		*(pData + j + 1) = __MOVE(key);
+	}
+}
+
+/* Raw scratch space for the buffered sorts, held for as long as a sort runs.
+   Every thread keeps one block around so sorting over and over again does not allocate every time,
+   but blocks bigger than MaxRetainedBytes are given back once the sort is done.
+   A sort that starts while the thread's block is in use (e.g. a predicate that sorts as well) gets a block of its own */
+class SortScratch final
+{
+public:
+	static constexpr uint64_t Alignment{ 64u };
+	static constexpr uint64_t MaxRetainedBytes{ 1024ull * 1024ull };
+
+	explicit SortScratch(const uint64_t bytes)
+		: m_pData{}
+		, m_bIsThreadBlock{}
+	{
+		Block& block{ GetBlock() };
+
+		if (block.bIsInUse)
+		{
+			m_pData = ::operator new(bytes, std::align_val_t{ Alignment });
+			return;
+		}
+
+		if (bytes > block.Size)
+		{
+			block.Release();
+
+			block.pData = ::operator new(bytes, std::align_val_t{ Alignment });
+			block.Size = bytes;
+		}
+
+		block.bIsInUse = true;
+
+		m_pData = block.pData;
+		m_bIsThreadBlock = true;
+	}
+	~SortScratch()
+	{
+		if (!m_bIsThreadBlock)
+		{
+			::operator delete(m_pData, std::align_val_t{ Alignment });
+			return;
+		}
+
+		Block& block{ GetBlock() };
+		block.bIsInUse = false;
+
+		if (block.Size > MaxRetainedBytes)
+			block.Release();
+	}
+
+	SortScratch(const SortScratch&) noexcept = delete;
+	SortScratch(SortScratch&&) noexcept = delete;
+	SortScratch& operator=(const SortScratch&) noexcept = delete;
+	SortScratch& operator=(SortScratch&&) noexcept = delete;
+
+	template<typename T>
+	__NODISCARD T* Get() const
+	{
+		static_assert(alignof(T) <= Alignment, "SortScratch::Get() > T is over-aligned!");
+
+		return static_cast<T*>(m_pData);
+	}
+
+private:
+	struct Block final
+	{
+		~Block() { Release(); }
+
+		void Release()
+		{
+			if (pData)
+				::operator delete(pData, std::align_val_t{ Alignment });
+
+			pData = nullptr;
+			Size = 0u;
+		}
+
+		void* pData{};
+		uint64_t Size{};
+		bool bIsInUse{};
+	};
+
+	__NODISCARD static Block& GetBlock()
+	{
+		thread_local Block block{};
+		return block;
+	}
+
+	void* m_pData;
+	bool m_bIsThreadBlock;
+};
+
+/* Calls sort(pBuffer) with raw scratch room for n elements */
+template<typename T, typename Sort>
+constexpr void WithSortScratch(const uint64_t n, const Sort& sort)
+{
+	if (std::is_constant_evaluated())
+	{
+		std::allocator<T> alloc{};
+		T* const pBuffer{ alloc.allocate(n) };
+
+		sort(pBuffer);
+
+		alloc.deallocate(pBuffer, n);
+	}
+	else
+	{
+		const SortScratch scratch{ n * sizeof(T) };
+		sort(scratch.Get<T>());
+	}
+}
+
+/* Merges the sorted runs [pData, pData + mid) and [pData + mid, pData + size), pBuffer must have raw room for mid elements */
+template<typename T, typename Pred>
+constexpr void BufferedMerge(T* const pData, const uint64_t mid, const uint64_t size, T* const pBuffer, const Pred& pred)
+{
+	/* The runs are already in order */
+	if (!pred(*(pData + mid), *(pData + mid - 1u)))
+		return;
+
+	for (uint64_t i{}; i < mid; ++i)
+		std::construct_at(pBuffer + i, __MOVE(*(pData + i)));
+
+	T* pLeft{ pBuffer };
+	T* const pLeftEnd{ pBuffer + mid };
+	T* pRight{ pData + mid };
+	T* const pRightEnd{ pData + size };
+	T* pOut{ pData };
+
+	/* Whatever is left of the right run is already in place, what is left of the left run fills the gap in front of it.
+	   This also happens when pred throws, so no element gets lost */
+	const auto finish{ [&pLeft, pLeftEnd, &pOut, pBuffer, mid]()->void
+		{
+			while (pLeft < pLeftEnd)
+				*pOut++ = __MOVE(*pLeft++);
+
+			for (uint64_t i{}; i < mid; ++i)
+				std::destroy_at(pBuffer + i);
+		} };
+
+	try
+	{
+		/* Taking from the left run on ties keeps the sort stable */
+		while (pLeft < pLeftEnd && pRight < pRightEnd)
+		{
+			if (pred(*pRight, *pLeft))
+				*pOut++ = __MOVE(*pRight++);
+			else
+				*pOut++ = __MOVE(*pLeft++);
+		}
+	}
+	catch (...)
+	{
+		finish();
+		throw;
+	}
+
+	finish();
+}
+
+/* Top-down merge sort, pBuffer must have raw room for size / 2 elements */
+template<typename T, typename Pred>
+constexpr void BufferedMergeSort(T* const pData, const uint64_t size, T* const pBuffer, const Pred& pred)
+{
+	if (size <= InsertionSortThreshold)
+	{
+		InsertionSort(pData, size, pred);
+		return;
+	}
+
+	const uint64_t mid{ size / 2u };
+
+	BufferedMergeSort(pData, mid, pBuffer, pred);
+	BufferedMergeSort(pData + mid, size - mid, pBuffer, pred);
+	BufferedMerge(pData, mid, size, pBuffer, pred);
+}
+
+/* The default stable sort of the containers, its scratch space comes from alloc */
+template<typename T, typename Pred, typename Alloc>
+constexpr void StableSort(T* const pData, const uint64_t size, const Pred& pred, Alloc& alloc)
+{
+	if (!pData)
+		return;
+
+	if (size < 64u)
+	{
+		InsertionSort(pData, size, pred);
+		return;
+	}
+
+	using AllocTraits = typename std::allocator_traits<Alloc>::template rebind_traits<T>;
+	typename AllocTraits::allocator_type tAlloc{ alloc };
+
+	T* const pBuffer{ AllocTraits::allocate(tAlloc, size / 2u) };
+
+	try
+	{
+		BufferedMergeSort(pData, size, pBuffer, pred);
+	}
+	catch (...)
+	{
+		AllocTraits::deallocate(tAlloc, pBuffer, size / 2u);
+		throw;
+	}
+
+	AllocTraits::deallocate(tAlloc, pBuffer, size / 2u);
+}
+
+/* The default stable sort of the containers, its scratch space is reused between calls on the same thread */
+template<typename T, typename Pred>
+constexpr void StableSort(T* const pData, const uint64_t size, const Pred& pred)
+{
+	if (!pData)
+		return;
+
+	if (size < 64u)
+	{
+		InsertionSort(pData, size, pred);
+		return;
+	}
+
+	WithSortScratch<T>(size / 2u, [pData, size, &pred](T* const pBuffer)
+		{
+			BufferedMergeSort(pData, size, pBuffer, pred);
+		});
+}
+
+#pragma region Adaptive Sort
+/* Number of elements one side has to win in a row before a merge switches to galloping */
+inline constexpr uint64_t MinGallop{ 7u };
+
+/* Returns the first index in [0, n) for which cond is false, cond has to be true for a prefix and false for the rest.
+   Searches exponentially from the start or the end first, so it is cheap when the answer is close to that end */
+template<typename T, typename Cond>
+constexpr uint64_t Gallop(const T* const pData, const uint64_t n, const bool bFromEnd, const Cond& cond)
+{
+	uint64_t lo{};
+	uint64_t hi{ n };
+
+	if (n == 0u)
+		return 0u;
+
+	if (!bFromEnd)
+	{
+		if (!cond(*pData))
+			return 0u;
+
+		uint64_t offset{ 1u };
+		while (offset < n && cond(*(pData + offset)))
+		{
+			lo = offset;
+			offset = offset * 2u + 1u;
+		}
+
+		hi = offset < n ? offset : n;
+		++lo;
+	}
+	else
+	{
+		if (cond(*(pData + n - 1u)))
+			return n;
+
+		hi = n - 1u;
+
+		uint64_t offset{ 1u };
+		while (offset < n && !cond(*(pData + n - 1u - offset)))
+		{
+			hi = n - 1u - offset;
+			offset = offset * 2u + 1u;
+		}
+
+		lo = offset < n ? n - offset : 0u;
+	}
+
+	while (lo < hi)
+	{
+		const uint64_t mid{ lo + (hi - lo) / 2u };
+
+		if (cond(*(pData + mid)))
+			lo = mid + 1u;
+		else
+			hi = mid;
+	}
+
+	return lo;
+}
+
+/* Amount of elements in [pData, pData + n) that go before key, equal elements go after it */
+template<typename T, typename Pred>
+constexpr uint64_t GallopLeft(const T& key, const T* const pData, const uint64_t n, const bool bFromEnd, const Pred& pred)
+{
+	return Gallop(pData, n, bFromEnd, [&key, &pred](const T& elem)->bool { return pred(elem, key); });
+}
+
+/* Amount of elements in [pData, pData + n) that go before key, equal elements go before it as well */
+template<typename T, typename Pred>
+constexpr uint64_t GallopRight(const T& key, const T* const pData, const uint64_t n, const bool bFromEnd, const Pred& pred)
+{
+	return Gallop(pData, n, bFromEnd, [&key, &pred](const T& elem)->bool { return !pred(key, elem); });
+}
+
+/* Merges [pA, pA + na) with [pA + na, pA + na + nb) front to back, pBuffer must have raw room for na elements */
+template<typename T, typename Pred>
+constexpr void MergeLow(T* const pA, const uint64_t na, const uint64_t nb, T* const pBuffer, const Pred& pred)
+{
+	T* const pB{ pA + na };
+
+	for (uint64_t i{}; i < na; ++i)
+		std::construct_at(pBuffer + i, __MOVE(*(pA + i)));
+
+	uint64_t ia{};
+	uint64_t ib{};
+
+	/* Whatever is left of B is already in place, what is left of the buffer fills the gap in front of it.
+	   This also happens when pred throws, so no element gets lost */
+	const auto finish{ [pA, na, &ia, &ib, pBuffer]()->void
+		{
+			for (; ia < na; ++ia)
+				*(pA + ia + ib) = __MOVE(*(pBuffer + ia));
+
+			for (uint64_t i{}; i < na; ++i)
+				std::destroy_at(pBuffer + i);
+		} };
+
+	try
+	{
+		while (ia < na && ib < nb)
+		{
+			uint64_t aWins{};
+			uint64_t bWins{};
+
+			/* One element at a time until one side keeps on winning */
+			while (ia < na && ib < nb && aWins < MinGallop && bWins < MinGallop)
+			{
+				if (pred(*(pB + ib), *(pBuffer + ia)))
+				{
+					*(pA + ia + ib) = __MOVE(*(pB + ib));
+					++ib;
+					++bWins;
+					aWins = 0u;
+				}
+				else
+				{
+					*(pA + ia + ib) = __MOVE(*(pBuffer + ia));
+					++ia;
+					++aWins;
+					bWins = 0u;
+				}
+			}
+
+			/* Galloping: look up how many elements in a row each side wins and move them all at once */
+			while (ia < na && ib < nb)
+			{
+				const uint64_t nrOfA{ GallopRight(*(pB + ib), pBuffer + ia, na - ia, false, pred) };
+
+				for (uint64_t i{}; i < nrOfA; ++i, ++ia)
+					*(pA + ia + ib) = __MOVE(*(pBuffer + ia));
+
+				if (ia == na)
+					break;
+
+				const uint64_t nrOfB{ GallopLeft(*(pBuffer + ia), pB + ib, nb - ib, false, pred) };
+
+				for (uint64_t i{}; i < nrOfB; ++i, ++ib)
+					*(pA + ia + ib) = __MOVE(*(pB + ib));
+
+				if (nrOfA < MinGallop && nrOfB < MinGallop)
+					break;
+			}
+		}
+	}
+	catch (...)
+	{
+		finish();
+		throw;
+	}
+
+	finish();
+}
+
+/* Merges [pA, pA + na) with [pA + na, pA + na + nb) back to front, pBuffer must have raw room for nb elements */
+template<typename T, typename Pred>
+constexpr void MergeHigh(T* const pA, const uint64_t na, const uint64_t nb, T* const pBuffer, const Pred& pred)
+{
+	T* const pB{ pA + na };
+
+	for (uint64_t i{}; i < nb; ++i)
+		std::construct_at(pBuffer + i, __MOVE(*(pB + i)));
+
+	/* The amount of elements of each run that still have to be placed */
+	uint64_t ra{ na };
+	uint64_t rb{ nb };
+
+	/* Whatever is left of A is already in place, what is left of the buffer fills the gap behind it.
+	   This also happens when pred throws, so no element gets lost */
+	const auto finish{ [pA, nb, &ra, &rb, pBuffer]()->void
+		{
+			for (; rb > 0u; --rb)
+				*(pA + ra + rb - 1u) = __MOVE(*(pBuffer + rb - 1u));
+
+			for (uint64_t i{}; i < nb; ++i)
+				std::destroy_at(pBuffer + i);
+		} };
+
+	try
+	{
+		while (ra > 0u && rb > 0u)
+		{
+			uint64_t aWins{};
+			uint64_t bWins{};
+
+			while (ra > 0u && rb > 0u && aWins < MinGallop && bWins < MinGallop)
+			{
+				if (pred(*(pBuffer + rb - 1u), *(pA + ra - 1u)))
+				{
+					*(pA + ra + rb - 1u) = __MOVE(*(pA + ra - 1u));
+					--ra;
+					++aWins;
+					bWins = 0u;
+				}
+				else
+				{
+					*(pA + ra + rb - 1u) = __MOVE(*(pBuffer + rb - 1u));
+					--rb;
+					++bWins;
+					aWins = 0u;
+				}
+			}
+
+			while (ra > 0u && rb > 0u)
+			{
+				/* Elements of A that go after the last remaining element of B */
+				const uint64_t nrOfA{ ra - GallopRight(*(pBuffer + rb - 1u), pA, ra, true, pred) };
+
+				for (uint64_t i{}; i < nrOfA; ++i, --ra)
+					*(pA + ra + rb - 1u) = __MOVE(*(pA + ra - 1u));
+
+				if (ra == 0u)
+					break;
+
+				/* Elements of B that go after the last remaining element of A */
+				const uint64_t nrOfB{ rb - GallopLeft(*(pA + ra - 1u), pBuffer, rb, true, pred) };
+
+				for (uint64_t i{}; i < nrOfB; ++i, --rb)
+					*(pA + ra + rb - 1u) = __MOVE(*(pBuffer + rb - 1u));
+
+				if (nrOfA < MinGallop && nrOfB < MinGallop)
+					break;
+			}
+		}
+	}
+	catch (...)
+	{
+		finish();
+		throw;
+	}
+
+	finish();
+}
+
+/* Merges the adjacent sorted runs [pA, pA + na) and [pA + na, pA + na + nb), pBuffer must have raw room for min(na, nb) elements */
+template<typename T, typename Pred>
+constexpr void MergeRuns(T* pA, uint64_t na, uint64_t nb, T* const pBuffer, const Pred& pred)
+{
+	T* const pB{ pA + na };
+
+	/* Elements of A that are not bigger than the first of B are already in place */
+	const uint64_t nrInPlace{ GallopRight(*pB, pA, na, false, pred) };
+
+	pA += nrInPlace;
+	na -= nrInPlace;
+
+	if (na == 0u)
+		return;
+
+	/* Same for elements of B that are not smaller than the last of A */
+	nb = GallopLeft(*(pA + na - 1u), pB, nb, true, pred);
+
+	if (nb == 0u)
+		return;
+
+	if (na <= nb)
+		MergeLow(pA, na, nb, pBuffer, pred);
+	else
+		MergeHigh(pA, na, nb, pBuffer, pred);
+}
+
+/* Finds the run starting at pData and returns its length, descending runs get reversed */
+template<typename T, typename Pred>
+constexpr uint64_t FindRun(T* const pData, const uint64_t n, const Pred& pred)
+{
+	if (n < 2u)
+		return n;
+
+	uint64_t runEnd{ 2u };
+
+	if (pred(*(pData + 1), *pData))
+	{
+		/* Only strictly descending, so reversing it keeps the sort stable */
+		while (runEnd < n && pred(*(pData + runEnd), *(pData + runEnd - 1u)))
+			++runEnd;
+
+		for (uint64_t i{}, j{ runEnd - 1u }; i < j; ++i, --j)
+			std::swap(*(pData + i), *(pData + j));
+	}
+	else
+	{
+		while (runEnd < n && !pred(*(pData + runEnd), *(pData + runEnd - 1u)))
+			++runEnd;
+	}
+
+	return runEnd;
+}
+
+/* Runs shorter than this get extended with insertion sort, chosen so that n / MinRun is (close to) a power of 2 */
+constexpr uint64_t CalculateMinRun(uint64_t n)
+{
+	uint64_t remainder{};
+
+	while (n >= 64u)
+	{
+		remainder |= n & 1u;
+		n >>= 1u;
+	}
+
+	return n + remainder;
+}
+
+/* Powersort's merge priority of the boundary between the runs [begin, mid) and [mid, end) out of n elements */
+constexpr uint64_t NodePower(const uint64_t begin, const uint64_t mid, const uint64_t end, const uint64_t n)
+{
+	uint64_t a{ begin + mid }; /* 2 * the middle of the left run */
+	uint64_t b{ mid + end }; /* 2 * the middle of the right run */
+	uint64_t power{};
+
+	while (true)
+	{
+		++power;
+
+		if (a >= n)
+		{
+			a -= n;
+			b -= n;
+		}
+		else if (b >= n)
+			break;
+
+		a <<= 1u;
+		b <<= 1u;
+	}
+
+	return power;
+}
+
+/* Stable merge sort that merges the runs already present in the input (Timsort's runs and galloping, Powersort's merge order) */
+template<typename T, typename Pred>
+constexpr void AdaptiveSort(T* const pData, const uint64_t size, const Pred& pred)
+{
+	if (!pData)
+		return;
+
+	if (size < 64u)
+	{
+		InsertionSort(pData, size, pred);
+		return;
+	}
+
+	WithSortScratch<T>(size / 2u, [pData, size, &pred](T* const pBuffer)
+		{
+			struct Run final
+			{
+				uint64_t Begin;
+				uint64_t Size;
+				uint64_t Power;
+			};
+
+			/* Powers on the stack are strictly increasing and at most 64 */
+			Run stack[66]{};
+			uint64_t stackSize{};
+
+			const uint64_t minRun{ CalculateMinRun(size) };
+
+			for (uint64_t begin{}; begin < size;)
+			{
+				uint64_t runSize{ FindRun(pData + begin, size - begin, pred) };
+
+				if (runSize < minRun)
+				{
+					runSize = minRun < size - begin ? minRun : size - begin;
+					InsertionSort(pData + begin, runSize, pred);
+				}
+
+				if (stackSize > 0u)
+				{
+					Run& top{ stack[stackSize - 1u] };
+					const uint64_t power{ NodePower(top.Begin, begin, begin + runSize, size) };
+
+					while (stackSize > 1u && stack[stackSize - 2u].Power > power)
+					{
+						Run& left{ stack[stackSize - 2u] };
+						Run& right{ stack[stackSize - 1u] };
+
+						MergeRuns(pData + left.Begin, left.Size, right.Size, pBuffer, pred);
+
+						left.Size += right.Size;
+						--stackSize;
+					}
+
+					stack[stackSize - 1u].Power = power;
+				}
+
+				stack[stackSize++] = Run{ begin, runSize, 0u };
+				begin += runSize;
+			}
+
+			for (; stackSize > 1u; --stackSize)
+			{
+				Run& left{ stack[stackSize - 2u] };
+				Run& right{ stack[stackSize - 1u] };
+
+				MergeRuns(pData + left.Begin, left.Size, right.Size, pBuffer, pred);
+
+				left.Size += right.Size;
+			}
+		});
+}
+#pragma endregion
+
+#pragma region Unstable Sort
+/* Pattern-defeating quicksort (Orson Peters' pdqsort): introsort with a heapsort fallback,
+   median-of-3 / ninther pivots, block partitioning for cheap comparisons and
+   insertion sort on partitions that turn out to be (nearly) sorted already */
+inline constexpr uint64_t PdqInsertionSortThreshold{ 24u };
+inline constexpr uint64_t PdqNintherThreshold{ 128u };
+inline constexpr uint64_t PdqPartialInsertionSortLimit{ 8u };
+inline constexpr uint64_t PdqBlockSize{ 64u };
+
+/* Insertion sort that expects an element not bigger than any in [pBegin, pEnd) right in front of pBegin */
+template<typename T, typename Pred>
+constexpr void UnguardedInsertionSort(T* const pBegin, T* const pEnd, const Pred& pred)
+{
+	for (T* pCurrent{ pBegin + 1 }; pCurrent < pEnd; ++pCurrent)
+	{
+		if (!pred(*pCurrent, *(pCurrent - 1)))
+			continue;
+
+		T key{ __MOVE(*pCurrent) };
+		T* pSift{ pCurrent };
+
+		do
+		{
+			*pSift = __MOVE(*(pSift - 1));
+			--pSift;
+		} while (pred(key, *(pSift - 1)));
+
+		*pSift = __MOVE(key);
+	}
+}
+
+/* Insertion sort that gives up (and returns false) once it had to move more than a handful of elements */
+template<typename T, typename Pred>
+constexpr bool PartialInsertionSort(T* const pBegin, T* const pEnd, const Pred& pred)
+{
+	uint64_t nrOfMoves{};
+
+	for (T* pCurrent{ pBegin + 1 }; pCurrent < pEnd; ++pCurrent)
+	{
+		if (!pred(*pCurrent, *(pCurrent - 1)))
+			continue;
+
+		T key{ __MOVE(*pCurrent) };
+		T* pSift{ pCurrent };
+
+		do
+		{
+			*pSift = __MOVE(*(pSift - 1));
+			--pSift;
+		} while (pSift != pBegin && pred(key, *(pSift - 1)));
+
+		*pSift = __MOVE(key);
+
+		nrOfMoves += static_cast<uint64_t>(pCurrent - pSift);
+		if (nrOfMoves > PdqPartialInsertionSortLimit)
+			return false;
+	}
+
+	return true;
+}
+
+template<typename T, typename Pred>
+constexpr void SortThree(T* const pA, T* const pB, T* const pC, const Pred& pred)
+{
+	if (pred(*pB, *pA))
+		std::swap(*pA, *pB);
+	if (pred(*pC, *pB))
+		std::swap(*pB, *pC);
+	if (pred(*pB, *pA))
+		std::swap(*pA, *pB);
+}
+
+/* Swaps the elements at pFirst + pOffsetsLeft[i] and pLast - pOffsetsRight[i] for every i < n.
+   Without bUseSwaps the swaps are done as one cyclic permutation, which moves each element only once */
+template<typename T>
+constexpr void SwapOffsets(T* const pFirst, T* const pLast, const unsigned char* const pOffsetsLeft, const unsigned char* const pOffsetsRight,
+	const uint64_t n, const bool bUseSwaps)
+{
+	if (bUseSwaps)
+	{
+		for (uint64_t i{}; i < n; ++i)
+			std::swap(*(pFirst + *(pOffsetsLeft + i)), *(pLast - *(pOffsetsRight + i)));
+	}
+	else if (n > 0u)
+	{
+		T* pLeft{ pFirst + *pOffsetsLeft };
+		T* pRight{ pLast - *pOffsetsRight };
+
+		T temp{ __MOVE(*pLeft) };
+		*pLeft = __MOVE(*pRight);
+
+		for (uint64_t i{ 1u }; i < n; ++i)
+		{
+			pLeft = pFirst + *(pOffsetsLeft + i);
+			*pRight = __MOVE(*pLeft);
+
+			pRight = pLast - *(pOffsetsRight + i);
+			*pLeft = __MOVE(*pRight);
+		}
+
+		*pRight = __MOVE(temp);
+	}
+}
+
+/* Partitions [pBegin, pEnd) around the pivot *pBegin, elements equal to it go to the right.
+   Returns the final position of the pivot and whether the range was partitioned already */
+template<bool Branchless, typename T, typename Pred>
+constexpr std::pair<T*, bool> PartitionRight(T* const pBegin, T* const pEnd, const Pred& pred)
+{
+	T pivot{ __MOVE(*pBegin) };
+
+	T* pFirst{ pBegin };
+	T* pLast{ pEnd };
+
+	/* The median of 3 guarantees there is an element >= pivot before the end */
+	while (pred(*++pFirst, pivot));
+
+	/* Without an element < pivot in front of us we have to guard against running off the start */
+	if (pFirst - 1 == pBegin)
+		while (pFirst < pLast && !pred(*--pLast, pivot));
+	else
+		while (!pred(*--pLast, pivot));
+
+	const bool bAlreadyPartitioned{ pFirst >= pLast };
+
+	if constexpr (Branchless)
+	{
+		if (!bAlreadyPartitioned)
+		{
+			std::swap(*pFirst, *pLast);
+			++pFirst;
+
+			/* Block partitioning (BlockQuicksort): first write down the offsets of the elements that are on the wrong side
+			   without branching on the comparisons, then swap them in bulk */
+			alignas(64) unsigned char offsetsLeft[PdqBlockSize];
+			alignas(64) unsigned char offsetsRight[PdqBlockSize];
+
+			T* pOffsetsLeftBase{ pFirst };
+			T* pOffsetsRightBase{ pLast };
+			uint64_t nrLeft{}, nrRight{}, startLeft{}, startRight{};
+
+			while (pFirst < pLast)
+			{
+				const uint64_t nrUnknown{ static_cast<uint64_t>(pLast - pFirst) };
+				const uint64_t leftSplit{ nrLeft == 0u ? (nrRight == 0u ? nrUnknown / 2u : nrUnknown) : 0u };
+				const uint64_t rightSplit{ nrRight == 0u ? nrUnknown - leftSplit : 0u };
+
+				const uint64_t leftBlock{ leftSplit < PdqBlockSize ? leftSplit : PdqBlockSize };
+				for (uint64_t i{}; i < leftBlock; ++i)
+				{
+					offsetsLeft[nrLeft] = static_cast<unsigned char>(i);
+					nrLeft += !pred(*pFirst, pivot);
+					++pFirst;
+				}
+
+				const uint64_t rightBlock{ rightSplit < PdqBlockSize ? rightSplit : PdqBlockSize };
+				for (uint64_t i{}; i < rightBlock;)
+				{
+					offsetsRight[nrRight] = static_cast<unsigned char>(++i);
+					nrRight += pred(*--pLast, pivot);
+				}
+
+				const uint64_t nrToSwap{ nrLeft < nrRight ? nrLeft : nrRight };
+				SwapOffsets(pOffsetsLeftBase, pOffsetsRightBase, offsetsLeft + startLeft, offsetsRight + startRight, nrToSwap, nrLeft == nrRight);
+
+				nrLeft -= nrToSwap;
+				nrRight -= nrToSwap;
+				startLeft += nrToSwap;
+				startRight += nrToSwap;
+
+				if (nrLeft == 0u)
+				{
+					startLeft = 0u;
+					pOffsetsLeftBase = pFirst;
+				}
+
+				if (nrRight == 0u)
+				{
+					startRight = 0u;
+					pOffsetsRightBase = pLast;
+				}
+			}
+
+			/* One of the sides still has elements on the wrong side, move them to the middle */
+			if (nrLeft > 0u)
+			{
+				while (nrLeft-- > 0u)
+					std::swap(*(pOffsetsLeftBase + offsetsLeft[startLeft + nrLeft]), *--pLast);
+
+				pFirst = pLast;
+			}
+
+			if (nrRight > 0u)
+			{
+				while (nrRight-- > 0u)
+					std::swap(*(pOffsetsRightBase - offsetsRight[startRight + nrRight]), *pFirst++);
+
+				pLast = pFirst;
+			}
+		}
+	}
+	else
+	{
+		while (pFirst < pLast)
+		{
+			std::swap(*pFirst, *pLast);
+
+			while (pred(*++pFirst, pivot));
+			while (!pred(*--pLast, pivot));
+		}
+	}
+
+	T* const pPivot{ pFirst - 1 };
+	*pBegin = __MOVE(*pPivot);
+	*pPivot = __MOVE(pivot);
+
+	return std::pair<T*, bool>{ pPivot, bAlreadyPartitioned };
+}
+
+/* Partitions [pBegin, pEnd) around the pivot *pBegin with elements equal to it going to the left,
+   used when the pivot equals the element in front of the range so that runs of duplicates get skipped in one go */
+template<typename T, typename Pred>
+constexpr T* PartitionLeft(T* const pBegin, T* const pEnd, const Pred& pred)
+{
+	T pivot{ __MOVE(*pBegin) };
+
+	T* pFirst{ pBegin };
+	T* pLast{ pEnd };
+
+	while (pred(pivot, *--pLast));
+
+	if (pLast + 1 == pEnd)
+		while (pFirst < pLast && !pred(pivot, *++pFirst));
+	else
+		while (!pred(pivot, *++pFirst));
+
+	while (pFirst < pLast)
+	{
+		std::swap(*pFirst, *pLast);
+
+		while (pred(pivot, *--pLast));
+		while (!pred(pivot, *++pFirst));
+	}
+
+	*pBegin = __MOVE(*pLast);
+	*pLast = __MOVE(pivot);
+
+	return pLast;
+}
+
+template<bool Branchless, typename T, typename Pred>
+constexpr void PdqSortLoop(T* pBegin, T* const pEnd, const Pred& pred, uint64_t nrOfBadPartitionsAllowed, bool bLeftmost)
+{
+	while (true)
+	{
+		const uint64_t size{ static_cast<uint64_t>(pEnd - pBegin) };
+
+		if (size < PdqInsertionSortThreshold)
+		{
+			if (bLeftmost)
+				InsertionSort(pBegin, size, pred);
+			else
+				UnguardedInsertionSort(pBegin, pEnd, pred);
+
+			return;
+		}
+
+		/* Put the pivot at the start */
+		const uint64_t half{ size / 2u };
+
+		if (size > PdqNintherThreshold)
+		{
+			SortThree(pBegin, pBegin + half, pEnd - 1, pred);
+			SortThree(pBegin + 1, pBegin + half - 1, pEnd - 2, pred);
+			SortThree(pBegin + 2, pBegin + half + 1, pEnd - 3, pred);
+			SortThree(pBegin + half - 1, pBegin + half, pBegin + half + 1, pred);
+
+			std::swap(*pBegin, *(pBegin + half));
+		}
+		else
+			SortThree(pBegin + half, pBegin, pEnd - 1, pred);
+
+		/* The element in front of us is equal to the pivot, so everything equal to it can go left and is done */
+		if (!bLeftmost && !pred(*(pBegin - 1), *pBegin))
+		{
+			pBegin = PartitionLeft(pBegin, pEnd, pred) + 1;
+			continue;
+		}
+
+		const auto [pPivot, bAlreadyPartitioned] { PartitionRight<Branchless>(pBegin, pEnd, pred) };
+
+		const uint64_t leftSize{ static_cast<uint64_t>(pPivot - pBegin) };
+		const uint64_t rightSize{ static_cast<uint64_t>(pEnd - (pPivot + 1)) };
+
+		if (leftSize < size / 8u || rightSize < size / 8u)
+		{
+			/* Too many bad partitions, switch to heapsort to keep O(n log n) */
+			if (--nrOfBadPartitionsAllowed == 0u)
+			{
+				std::make_heap(pBegin, pEnd, pred);
+				std::sort_heap(pBegin, pEnd, pred);
+
+				return;
+			}
+
+			/* Break up patterns that make our pivots bad */
+			if (leftSize >= PdqInsertionSortThreshold)
+			{
+				std::swap(*pBegin, *(pBegin + leftSize / 4u));
+				std::swap(*(pPivot - 1), *(pPivot - leftSize / 4u));
+
+				if (leftSize > PdqNintherThreshold)
+				{
+					std::swap(*(pBegin + 1), *(pBegin + (leftSize / 4u + 1u)));
+					std::swap(*(pBegin + 2), *(pBegin + (leftSize / 4u + 2u)));
+					std::swap(*(pPivot - 2), *(pPivot - (leftSize / 4u + 1u)));
+					std::swap(*(pPivot - 3), *(pPivot - (leftSize / 4u + 2u)));
+				}
+			}
+
+			if (rightSize >= PdqInsertionSortThreshold)
+			{
+				std::swap(*(pPivot + 1), *(pPivot + (1u + rightSize / 4u)));
+				std::swap(*(pEnd - 1), *(pEnd - rightSize / 4u));
+
+				if (rightSize > PdqNintherThreshold)
+				{
+					std::swap(*(pPivot + 2), *(pPivot + (2u + rightSize / 4u)));
+					std::swap(*(pPivot + 3), *(pPivot + (3u + rightSize / 4u)));
+					std::swap(*(pEnd - 2), *(pEnd - (1u + rightSize / 4u)));
+					std::swap(*(pEnd - 3), *(pEnd - (2u + rightSize / 4u)));
+				}
+			}
+		}
+		else if (bAlreadyPartitioned && PartialInsertionSort(pBegin, pPivot, pred) && PartialInsertionSort(pPivot + 1, pEnd, pred))
+		{
+			/* The partition did not swap anything and both sides were nearly sorted, so we are done */
+			return;
+		}
+
+		/* Recurse into the left side and loop on the right side */
+		PdqSortLoop<Branchless>(pBegin, pPivot, pred, nrOfBadPartitionsAllowed, bLeftmost);
+
+		pBegin = pPivot + 1;
+		bLeftmost = false;
+	}
+}
+
+/* The unstable sort of the containers, O(n log n) worst case and linear on sorted or reversed input */
+template<typename T, typename Pred>
+constexpr void UnstableSort(T* const pData, const uint64_t size, const Pred& pred)
+{
+	if (!pData || size < 2u)
+		return;
+
+	uint64_t log2{};
+	for (uint64_t n{ size }; n >>= 1u;)
+		++log2;
+
+	/* Branchless partitioning only pays off when comparing is cheap */
+	constexpr bool bBranchless{ std::is_arithmetic_v<T> || std::is_pointer_v<T> };
+
+	PdqSortLoop<bBranchless>(pData, pData + size, pred, log2, true);
+}
+#pragma endregion
+
+#pragma region Radix Sort
+/* Below this amount of elements the histograms cost more than comparing */
+inline constexpr uint64_t RadixSortThreshold{ 64u };
+
+/* Maps a key onto an unsigned integer with the same order, so the radix sort only has to deal with unsigned digits.
+   Floating points sort like std::less would except that -0.0 comes before 0.0 and NaNs end up at either end depending on their sign */
+template<typename Key>
+__NODISCARD constexpr auto ToRadixKey(const Key key)
+{
+	static_assert(std::is_arithmetic_v<Key> || std::is_enum_v<Key>, "ToRadixKey() > Keys must be integers, floating points or enums!");
+	static_assert(sizeof(Key) <= 8u, "ToRadixKey() > Keys can be at most 64 bits!");
+
+	if constexpr (std::is_enum_v<Key>)
+		return ToRadixKey(static_cast<std::underlying_type_t<Key>>(key));
+	else if constexpr (std::is_same_v<Key, bool>)
+		return static_cast<uint8_t>(key);
+	else if constexpr (std::is_floating_point_v<Key>)
+	{
+		using Bits = std::conditional_t<sizeof(Key) == 4u, uint32_t, uint64_t>;
+		constexpr Bits signBit{ Bits{ 1u } << (sizeof(Bits) * 8u - 1u) };
+
+		const Bits bits{ std::bit_cast<Bits>(key) };
+
+		/* Negative numbers get all their bits flipped so bigger magnitudes come first, positive numbers only their sign bit */
+		return (bits & signBit) ? static_cast<Bits>(~bits) : static_cast<Bits>(bits | signBit);
+	}
+	else
+	{
+		using Bits = std::make_unsigned_t<Key>;
+
+		if constexpr (std::is_signed_v<Key>)
+			return static_cast<Bits>(static_cast<Bits>(key) ^ (Bits{ 1u } << (sizeof(Bits) * 8u - 1u)));
+		else
+			return static_cast<Bits>(key);
+	}
+}
+
+/* One LSD pass per DigitBits bits of the key, ping-ponging between pData and a scratch buffer */
+template<uint64_t DigitBits, typename T, typename KeyOf>
+void RadixSortWithDigits(T* const pData, const uint64_t size, const KeyOf& keyOf)
+{
+	using Bits = decltype(ToRadixKey(keyOf(*pData)));
+
+	constexpr uint64_t NrOfPasses{ (sizeof(Bits) * 8u + DigitBits - 1u) / DigitBits };
+	constexpr uint64_t NrOfBuckets{ 1ull << DigitBits };
+	constexpr uint64_t Mask{ NrOfBuckets - 1u };
+
+	/* The buffer and the histograms of every pass share the per-thread scratch block */
+	const uint64_t bufferBytes{ (size * sizeof(T) + SortScratch::Alignment - 1u) & ~(SortScratch::Alignment - 1u) };
+	const SortScratch scratch{ bufferBytes + NrOfPasses * NrOfBuckets * sizeof(uint64_t) };
+	unsigned char* const pBlock{ scratch.Get<unsigned char>() };
+
+	T* const pBuffer{ reinterpret_cast<T*>(pBlock) };
+	uint64_t* const pCounts{ reinterpret_cast<uint64_t*>(pBlock + bufferBytes) };
+
+	std::fill(pCounts, pCounts + NrOfPasses * NrOfBuckets, 0u);
+
+	/* A single read of the keys builds the histograms of all digits */
+	for (uint64_t i{}; i < size; ++i)
+	{
+		const uint64_t key{ ToRadixKey(keyOf(*(pData + i))) };
+
+		for (uint64_t pass{}; pass < NrOfPasses; ++pass)
+			++pCounts[pass * NrOfBuckets + ((key >> (pass * DigitBits)) & Mask)];
+	}
+
+	const uint64_t firstKey{ ToRadixKey(keyOf(*pData)) };
+
+	T* pSource{ pData };
+	T* pDestination{ pBuffer };
+	bool bIsBufferConstructed{ false };
+
+	/* Elements that have to be destroyed are moved into the buffer in order up front, so if keyOf throws halfway through a pass
+	   the buffer is completely built and can simply be destroyed, instead of holding elements at places we lost track of */
+	if constexpr (!std::is_trivially_destructible_v<T>)
+	{
+		std::uninitialized_move(pData, pData + size, pBuffer);
+		std::swap(pSource, pDestination);
+
+		bIsBufferConstructed = true;
+	}
+
+	try
+	{
+		for (uint64_t pass{}; pass < NrOfPasses; ++pass)
+		{
+			uint64_t* const pOffsets{ pCounts + pass * NrOfBuckets };
+			const uint64_t shift{ pass * DigitBits };
+
+			/* Every key has the same digit here (e.g. the upper bytes of small integers), so the pass would not change anything */
+			if (pOffsets[(firstKey >> shift) & Mask] == size)
+				continue;
+
+			/* Turn the histogram into the offset each bucket starts at */
+			uint64_t offset{};
+			for (uint64_t bucket{}; bucket < NrOfBuckets; ++bucket)
+			{
+				const uint64_t count{ pOffsets[bucket] };
+				pOffsets[bucket] = offset;
+				offset += count;
+			}
+
+			if (pDestination == pBuffer && !bIsBufferConstructed)
+			{
+				for (uint64_t i{}; i < size; ++i)
+				{
+					const uint64_t digit{ (static_cast<uint64_t>(ToRadixKey(keyOf(*(pSource + i)))) >> shift) & Mask };
+					std::construct_at(pDestination + pOffsets[digit]++, __MOVE(*(pSource + i)));
+				}
+
+				bIsBufferConstructed = true;
+			}
+			else
+			{
+				for (uint64_t i{}; i < size; ++i)
+				{
+					const uint64_t digit{ (static_cast<uint64_t>(ToRadixKey(keyOf(*(pSource + i)))) >> shift) & Mask };
+					*(pDestination + pOffsets[digit]++) = __MOVE(*(pSource + i));
+				}
+			}
+
+			std::swap(pSource, pDestination);
+		}
+
+		if (pSource != pData)
+		{
+			for (uint64_t i{}; i < size; ++i)
+				*(pData + i) = __MOVE(*(pSource + i));
+		}
+	}
+	catch (...)
+	{
+		if (bIsBufferConstructed)
+			std::destroy(pBuffer, pBuffer + size);
+
+		throw;
+	}
+
+	if (bIsBufferConstructed)
+		std::destroy(pBuffer, pBuffer + size);
+}
+
+/* Stable LSD radix sort on the key keyOf(element) returns, which has to be an integer, floating point or enum.
+   Runs in a few linear passes: 8 bit digits for small arrays, 11 bit digits otherwise and 16 bit digits for 16 bit keys */
+template<typename T, typename KeyOf>
+void LsdRadixSort(T* const pData, const uint64_t size, const KeyOf& keyOf)
+{
+	if (!pData || size < 2u)
+		return;
+
+	using Bits = decltype(ToRadixKey(keyOf(*pData)));
+
+	if (size < RadixSortThreshold)
+	{
+		InsertionSort(pData, size, [&keyOf](const T& a, const T& b)->bool
+			{
+				return ToRadixKey(keyOf(a)) < ToRadixKey(keyOf(b));
+			});
+	}
+	else if constexpr (sizeof(Bits) == 1u)
+		RadixSortWithDigits<8u>(pData, size, keyOf);
+	else if constexpr (sizeof(Bits) == 2u)
+	{
+		if (size < (1ull << 16u))
+			RadixSortWithDigits<8u>(pData, size, keyOf);
+		else
+			RadixSortWithDigits<16u>(pData, size, keyOf);
+	}
+	else
+	{
+		if (size < (1ull << 16u))
+			RadixSortWithDigits<8u>(pData, size, keyOf);
+		else
+			RadixSortWithDigits<11u>(pData, size, keyOf);
+	}
+}
+#pragma endregion
+
+#pragma region Parallel Sort
+/* Below this amount of elements threads cost more than they save and ParallelStableSort() is just StableSort() */
+inline constexpr uint64_t ParallelSortThreshold{ 1ull << 16u };
+
+/* The amount of elements of the left run a stable merge of [pLeft, pLeft + leftSize) and [pRight, pRight + rightSize)
+   puts among its first k elements, so a merge can be cut into pieces that are merged independently */
+template<typename T, typename Pred>
+__NODISCARD uint64_t MergeCoRank(const uint64_t k, const T* const pLeft, const uint64_t leftSize, const T* const pRight, const uint64_t rightSize,
+	const Pred& pred)
+{
+	uint64_t low{ k > rightSize ? k - rightSize : 0u };
+	uint64_t high{ k < leftSize ? k : leftSize };
+
+	while (low < high)
+	{
+		const uint64_t i{ low + (high - low) / 2u };
+
+		/* Left[i] goes in front of right[k - i - 1], so more of the left run belongs to the first k */
+		if (!pred(*(pRight + (k - i - 1u)), *(pLeft + i)))
+			low = i + 1u;
+		else
+			high = i;
+	}
+
+	return low;
+}
+
+/* Stable merge of [pLeft, pLeftEnd) and [pRight, pRightEnd) into pOut, which holds raw memory if Construct is true */
+template<bool Construct, typename T, typename Pred>
+void MergeInto(T* pLeft, T* const pLeftEnd, T* pRight, T* const pRightEnd, T* const pOut, const Pred& pred)
+{
+	T* pCurrent{ pOut };
+
+	const auto put{ [&pCurrent](T& value)->void
+		{
+			if constexpr (Construct)
+				std::construct_at(pCurrent, __MOVE(value));
+			else
+				*pCurrent = __MOVE(value);
+
+			++pCurrent;
+		} };
+
+	try
+	{
+		while (pLeft != pLeftEnd && pRight != pRightEnd)
+		{
+			if (pred(*pRight, *pLeft))
+				put(*pRight++);
+			else
+				put(*pLeft++);
+		}
+
+		while (pLeft != pLeftEnd)
+			put(*pLeft++);
+
+		while (pRight != pRightEnd)
+			put(*pRight++);
+	}
+	catch (...)
+	{
+		/* Don't leave the raw memory half constructed */
+		if constexpr (Construct)
+			std::destroy(pOut, pCurrent);
+
+		throw;
+	}
+}
+
+/* Stable parallel merge sort: every thread sorts a run with StableSort(), after which the runs are merged pairwise.
+   Each round of merges is cut into as many independent pieces as there are threads, so the last rounds use every thread as well */
+template<typename T, typename Pred>
+void ParallelStableSort(T* const pData, const uint64_t size, const Pred& pred, ThreadPool& pool)
+{
+	const uint64_t nrOfThreads{ pool.GetNrOfThreads() };
+
+	if (!pData || size < ParallelSortThreshold || nrOfThreads < 2u)
+	{
+		StableSort(pData, size, pred);
+		return;
+	}
+
+	const uint64_t nrOfRuns{ nrOfThreads };
+
+	std::vector<uint64_t> bounds(nrOfRuns + 1u);
+	for (uint64_t i{}; i <= nrOfRuns; ++i)
+		bounds[i] = size * i / nrOfRuns;
+
+	{
+		TaskGroup group{ pool };
+
+		for (uint64_t run{}; run < nrOfRuns; ++run)
+		{
+			/* The scratch space is allocated and freed by the task itself, so no worker holds on to it after the sort */
+			group.Run([pData, &bounds, run, &pred]()
+				{
+					std::allocator<T> runAlloc{};
+					StableSort(pData + bounds[run], bounds[run + 1u] - bounds[run], pred, runAlloc);
+				});
+		}
+
+		group.Wait();
+	}
+
+	std::allocator<T> alloc{};
+	T* const pBuffer{ alloc.allocate(size) };
+
+	T* pSource{ pData };
+	T* pDestination{ pBuffer };
+	bool bIsBufferConstructed{ false };
+
+	/* The parts of the buffer the first round constructed, so they can be destroyed again if pred throws halfway */
+	std::vector<std::pair<uint64_t, uint64_t>> constructedPieces{};
+
+	try
+	{
+		for (uint64_t width{ 1u }; width < nrOfRuns; width *= 2u)
+		{
+			const uint64_t nrOfMerges{ (nrOfRuns + 2u * width - 1u) / (2u * width) };
+			const uint64_t nrOfPieces{ (nrOfThreads + nrOfMerges - 1u) / nrOfMerges };
+			const bool bConstruct{ pDestination == pBuffer && !bIsBufferConstructed };
+
+			if (bConstruct)
+				constructedPieces.assign(nrOfMerges * nrOfPieces, std::pair<uint64_t, uint64_t>{});
+
+			std::pair<uint64_t, uint64_t>* const pConstructedPieces{ constructedPieces.data() };
+
+			TaskGroup group{ pool };
+
+			for (uint64_t run{}; run < nrOfRuns; run += 2u * width)
+			{
+				/* Every round writes every element, an odd run out just gets moved */
+				const uint64_t begin{ bounds[run] };
+				const uint64_t mid{ bounds[run + width < nrOfRuns ? run + width : nrOfRuns] };
+				const uint64_t end{ bounds[run + 2u * width < nrOfRuns ? run + 2u * width : nrOfRuns] };
+
+				for (uint64_t piece{}; piece < nrOfPieces; ++piece)
+				{
+					std::pair<uint64_t, uint64_t>* const pConstructed{ bConstruct ? pConstructedPieces + (run / (2u * width)) * nrOfPieces + piece : nullptr };
+
+					group.Run([pSource, pDestination, begin, mid, end, piece, nrOfPieces, pConstructed, &pred]()
+						{
+							T* const pLeft{ pSource + begin };
+							T* const pRight{ pSource + mid };
+
+							const uint64_t first{ (end - begin) * piece / nrOfPieces };
+							const uint64_t last{ (end - begin) * (piece + 1u) / nrOfPieces };
+
+							const uint64_t leftFirst{ MergeCoRank(first, pLeft, mid - begin, pRight, end - mid, pred) };
+							const uint64_t leftLast{ MergeCoRank(last, pLeft, mid - begin, pRight, end - mid, pred) };
+
+							if (pConstructed)
+							{
+								MergeInto<true>(pLeft + leftFirst, pLeft + leftLast, pRight + (first - leftFirst), pRight + (last - leftLast),
+									pDestination + begin + first, pred);
+
+								*pConstructed = std::pair<uint64_t, uint64_t>{ begin + first, begin + last };
+							}
+							else
+								MergeInto<false>(pLeft + leftFirst, pLeft + leftLast, pRight + (first - leftFirst), pRight + (last - leftLast),
+									pDestination + begin + first, pred);
+						});
+				}
+			}
+
+			group.Wait();
+
+			bIsBufferConstructed = bIsBufferConstructed || bConstruct;
+			std::swap(pSource, pDestination);
+		}
+	}
+	catch (...)
+	{
+		if (bIsBufferConstructed)
+			std::destroy(pBuffer, pBuffer + size);
+		else
+		{
+			for (const std::pair<uint64_t, uint64_t>& piece : constructedPieces)
+				std::destroy(pBuffer + piece.first, pBuffer + piece.second);
+		}
+
+		alloc.deallocate(pBuffer, size);
+
+		throw;
+	}
+
+	/* An odd amount of rounds leaves the sorted elements in the buffer */
+	if (pSource != pData)
+	{
+		TaskGroup group{ pool };
+
+		for (uint64_t run{}; run < nrOfRuns; ++run)
+		{
+			group.Run([pData, pBuffer, &bounds, run]()
+				{
+					for (uint64_t i{ bounds[run] }; i < bounds[run + 1u]; ++i)
+						*(pData + i) = __MOVE(*(pBuffer + i));
+				});
+		}
+
+		group.Wait();
+	}
+
+	if (bIsBufferConstructed)
+		std::destroy(pBuffer, pBuffer + size);
+
+	alloc.deallocate(pBuffer, size);
+}
+
+/* ParallelStableSort() on the process-wide thread pool */
+template<typename T, typename Pred>
+void ParallelStableSort(T* const pData, const uint64_t size, const Pred& pred)
+{
+	ParallelStableSort(pData, size, pred, ThreadPool::GetInstance());
+}
+#pragma endregion
+
+template<typename T, typename Pred>
+constexpr void SortWithMode(T* const pData, const uint64_t size, const Pred& pred, const SortMode mode)
+{
+	switch (mode)
+	{
+	case SortMode::Merge:
+		StableSort(pData, size, pred);
+		break;
+	case SortMode::Adaptive:
+		AdaptiveSort(pData, size, pred);
+		break;
+	}
+}
@@ -0,0 +1,295 @@
+#pragma once
+
+#include "Utils.h"
+
+#include <stdint.h>
+#include <atomic> /* std::atomic */
+#include <condition_variable> /* std::condition_variable */
+#include <deque> /* std::deque */
+#include <exception> /* std::exception_ptr, std::current_exception, std::rethrow_exception */
+#include <functional> /* std::function */
+#include <memory> /* std::unique_ptr */
+#include <mutex> /* std::mutex, std::lock_guard, std::unique_lock */
+#include <thread> /* std::thread */
+#include <vector> /* std::vector */
+
+/* Work-stealing thread pool.
+   Every thread has its own task queue: a thread pushes and pops at the back of its own queue and,
+   once that runs dry, steals from the front of the others.
+   A pool of n threads starts n - 1 workers, the n-th thread is whoever waits on a TaskGroup, since waiting runs tasks too */
+class ThreadPool final
+{
+public:
+	explicit ThreadPool(const uint64_t nrOfThreads = GetHardwareConcurrency())
+		: m_Queues{}
+		, m_Workers{}
+		, m_SleepMutex{}
+		, m_WakeUp{}
+		, m_NrOfPendingTasks{}
+		, m_bIsStopping{}
+	{
+		const uint64_t nrOfQueues{ nrOfThreads > 0u ? nrOfThreads : 1u };
+
+		/* Queue 0 is shared by every thread that is not a worker of this pool */
+		for (uint64_t i{}; i < nrOfQueues; ++i)
+			m_Queues.push_back(std::make_unique<TaskQueue>());
+
+		for (uint64_t i{ 1u }; i < nrOfQueues; ++i)
+			m_Workers.emplace_back([this, i]() { WorkerLoop(i); });
+	}
+	~ThreadPool()
+	{
+		{
+			const std::lock_guard<std::mutex> lock{ m_SleepMutex };
+			m_bIsStopping = true;
+		}
+
+		m_WakeUp.notify_all();
+
+		for (std::thread& worker : m_Workers)
+			worker.join();
+	}
+
+	ThreadPool(const ThreadPool&) noexcept = delete;
+	ThreadPool(ThreadPool&&) noexcept = delete;
+	ThreadPool& operator=(const ThreadPool&) noexcept = delete;
+	ThreadPool& operator=(ThreadPool&&) noexcept = delete;
+
+	/* The process-wide pool, with a thread per hardware thread */
+	__NODISCARD static ThreadPool& GetInstance()
+	{
+		static ThreadPool pool{};
+		return pool;
+	}
+
+	__NODISCARD static uint64_t GetHardwareConcurrency()
+	{
+		const uint64_t nrOfThreads{ std::thread::hardware_concurrency() };
+		return nrOfThreads > 0u ? nrOfThreads : 1u;
+	}
+
+	__NODISCARD uint64_t GetNrOfThreads() const
+	{
+		return m_Queues.size();
+	}
+
+	template<typename Function>
+	void Submit(Function&& function)
+	{
+		TaskQueue& queue{ *m_Queues[GetOwnQueueIndex()] };
+
+		/* Counted before it can be popped, otherwise the count could drop below zero for a moment */
+		++m_NrOfPendingTasks;
+
+		{
+			const std::lock_guard<std::mutex> lock{ queue.Mutex };
+			queue.Tasks.emplace_back(__FORWARD(function));
+		}
+
+		/* Taking the lock makes sure a worker checking for work right now either sees the task or gets woken up */
+		{
+			const std::lock_guard<std::mutex> lock{ m_SleepMutex };
+		}
+
+		m_WakeUp.notify_one();
+	}
+
+	/* Runs one task of the calling thread's queue, or one stolen from another queue. Returns false if there was none */
+	bool TryRunTask()
+	{
+		std::function<void()> task{};
+
+		if (!TryPopTask(GetOwnQueueIndex(), task))
+			return false;
+
+		task();
+
+		return true;
+	}
+
+	/* Sleeps until there is a task to run or bIsDone() returns true. Whoever makes bIsDone() true has to call WakeUpAll() */
+	template<typename Pred>
+	void WaitForTaskOr(const Pred& bIsDone)
+	{
+		std::unique_lock<std::mutex> lock{ m_SleepMutex };
+		m_WakeUp.wait(lock, [this, &bIsDone]()->bool { return m_bIsStopping || m_NrOfPendingTasks > 0u || bIsDone(); });
+	}
+
+	void WakeUpAll()
+	{
+		{
+			const std::lock_guard<std::mutex> lock{ m_SleepMutex };
+		}
+
+		m_WakeUp.notify_all();
+	}
+
+private:
+	struct TaskQueue final
+	{
+		std::mutex Mutex;
+		std::deque<std::function<void()>> Tasks;
+	};
+
+	struct WorkerInfo final
+	{
+		const ThreadPool* pPool;
+		uint64_t QueueIndex;
+	};
+
+	__NODISCARD static WorkerInfo& GetWorkerInfo()
+	{
+		thread_local WorkerInfo info{};
+		return info;
+	}
+
+	__NODISCARD uint64_t GetOwnQueueIndex() const
+	{
+		const WorkerInfo& info{ GetWorkerInfo() };
+		return info.pPool == this ? info.QueueIndex : 0u;
+	}
+
+	bool TryPopTask(const uint64_t ownIndex, std::function<void()>& task)
+	{
+		/* Newest task of our own queue first, its data is most likely still in cache */
+		{
+			TaskQueue& queue{ *m_Queues[ownIndex] };
+			const std::lock_guard<std::mutex> lock{ queue.Mutex };
+
+			if (!queue.Tasks.empty())
+			{
+				task = __MOVE(queue.Tasks.back());
+				queue.Tasks.pop_back();
+				--m_NrOfPendingTasks;
+
+				return true;
+			}
+		}
+
+		/* Steal the oldest task of another queue, which tends to be the biggest piece of work */
+		const uint64_t nrOfQueues{ m_Queues.size() };
+		for (uint64_t i{ 1u }; i < nrOfQueues; ++i)
+		{
+			TaskQueue& queue{ *m_Queues[(ownIndex + i) % nrOfQueues] };
+			const std::lock_guard<std::mutex> lock{ queue.Mutex };
+
+			if (!queue.Tasks.empty())
+			{
+				task = __MOVE(queue.Tasks.front());
+				queue.Tasks.pop_front();
+				--m_NrOfPendingTasks;
+
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	void WorkerLoop(const uint64_t queueIndex)
+	{
+		GetWorkerInfo() = WorkerInfo{ this, queueIndex };
+
+		while (true)
+		{
+			std::function<void()> task{};
+
+			if (TryPopTask(queueIndex, task))
+			{
+				task();
+				continue;
+			}
+
+			std::unique_lock<std::mutex> lock{ m_SleepMutex };
+			m_WakeUp.wait(lock, [this]()->bool { return m_bIsStopping || m_NrOfPendingTasks > 0u; });
+
+			if (m_bIsStopping)
+				return;
+		}
+	}
+
+	std::vector<std::unique_ptr<TaskQueue>> m_Queues;
+	std::vector<std::thread> m_Workers;
+
+	std::mutex m_SleepMutex;
+	std::condition_variable m_WakeUp;
+	std::atomic<uint64_t> m_NrOfPendingTasks;
+	bool m_bIsStopping;
+};
+
+/* A batch of tasks on a ThreadPool that can be waited on. The first exception a task throws is rethrown by Wait() */
+class TaskGroup final
+{
+public:
+	explicit TaskGroup(ThreadPool& pool)
+		: m_Pool{ pool }
+		, m_NrOfUnfinishedTasks{}
+		, m_ExceptionMutex{}
+		, m_pException{}
+	{}
+	~TaskGroup()
+	{
+		/* Tasks still refer to the group, so they have to be done before it goes away */
+		HelpUntilDone();
+	}
+
+	TaskGroup(const TaskGroup&) noexcept = delete;
+	TaskGroup(TaskGroup&&) noexcept = delete;
+	TaskGroup& operator=(const TaskGroup&) noexcept = delete;
+	TaskGroup& operator=(TaskGroup&&) noexcept = delete;
+
+	template<typename Function>
+	void Run(Function&& function)
+	{
+		++m_NrOfUnfinishedTasks;
+
+		m_Pool.Submit([this, pPool = &m_Pool, function = __FORWARD(function)]()
+			{
+				try
+				{
+					function();
+				}
+				catch (...)
+				{
+					const std::lock_guard<std::mutex> lock{ m_ExceptionMutex };
+
+					if (!m_pException)
+						m_pException = std::current_exception();
+				}
+
+				/* The group can be gone as soon as the count hits zero, so only the pool is touched after that */
+				if (--m_NrOfUnfinishedTasks == 0u)
+					pPool->WakeUpAll();
+			});
+	}
+
+	/* Helps running tasks until every task of the group is done */
+	void Wait()
+	{
+		HelpUntilDone();
+
+		if (m_pException)
+		{
+			std::exception_ptr pException{ m_pException };
+			m_pException = nullptr;
+
+			std::rethrow_exception(pException);
+		}
+	}
+
+private:
+	/* Runs queued tasks while there are any, and sleeps until there are new ones or the group is done otherwise */
+	void HelpUntilDone()
+	{
+		while (m_NrOfUnfinishedTasks > 0u)
+		{
+			if (!m_Pool.TryRunTask())
+				m_Pool.WaitForTaskOr([this]()->bool { return m_NrOfUnfinishedTasks == 0u; });
+		}
+	}
+
+	ThreadPool& m_Pool;
+	std::atomic<uint64_t> m_NrOfUnfinishedTasks;
+	std::mutex m_ExceptionMutex;
+	std::exception_ptr m_pException;
+};
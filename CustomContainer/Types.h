@@ -3,6 +3,7 @@
 #include "Utils.h"
 
 #include <stdint.h>
+#include <type_traits> /* std::is_trivially_copyable */
 
 struct Size_P final
 {
@@ -21,11 +22,19 @@ struct Capacity_P final
 	uint64_t _Capacity;
 };
 
-__NODISCARD __INLINE constexpr Size_P operator""_size(const uint64_t i)
+/* Types for which a memcpy to a new address followed by NOT calling the destructor on the old address
+   is equivalent to a move construction + destruction. Specialize this for types such as a struct holding a std::unique_ptr */
+template<typename T>
+struct IsTriviallyRelocatable : std::is_trivially_copyable<T> {};
+
+template<typename T>
+inline constexpr bool IsTriviallyRelocatable_v = IsTriviallyRelocatable<T>::value;
+
+__NODISCARD __INLINE constexpr Size_P operator""_size(const unsigned long long i)
 {
 	return Size_P{ i };
 }
-__NODISCARD __INLINE constexpr Capacity_P operator""_capacity(const uint64_t i)
+__NODISCARD __INLINE constexpr Capacity_P operator""_capacity(const unsigned long long i)
 {
 	return Capacity_P{ i };
 }
\ No newline at end of file
@@ -5,14 +5,27 @@
 /* [[nodiscard]] */
 #define __NODISCARD [[nodiscard]]
 
+	/* [[no_unique_address]] */
+#ifdef _MSC_VER
+#define __NO_UNIQUE_ADDRESS [[msvc::no_unique_address]]
+#else
+#define __NO_UNIQUE_ADDRESS [[no_unique_address]]
+#endif
+
 	/* inline */
 #ifdef _WIN32
 #define __INLINE __forceinline
+#else
+#define __INLINE inline __attribute__((always_inline))
 #endif
 
 	/* ASSERT() */
 #ifdef _DEBUG
+#ifdef _WIN32
 #define __BREAK() __debugbreak()
+#else
+#define __BREAK() __builtin_trap()
+#endif
 #define __ASSERT(expr) \
 	if ((expr)) {} \
 	else \
@@ -41,7 +54,7 @@
 
 	/* std::forward */
 #ifdef _DEBUG
-#define __FORWARD(val) static_cast<decltype((val))&&>((val))
+#define __FORWARD(val) static_cast<decltype(val)&&>(val)
 #else
-#define __FORWARD(val) std::forward<decltype((val))>((val))
+#define __FORWARD(val) std::forward<decltype(val)>(val)
 #endif
\ No newline at end of file
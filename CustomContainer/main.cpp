@@ -1,10 +1,16 @@
 #include "CustomContainer.h" // CustomContainer also includes iostream, so no need to reinclude it here
+#include "ReallocAllocator.h"
+#include "InplaceArray.h"
+#include "ArenaAllocator.h"
+#include "PoolAllocator.h"
 #include <numeric> // std::accumulate
 #include <chrono> // std::chrono
 #include <vector> // std::vector
 #include <fstream> // std::ofstream
 #include <algorithm> // std::max_element, std::min_element, std::remove_if
 #include <deque> /* std::deque */
+#include <thread> /* std::thread */
+#include <stdexcept> /* std::runtime_error */
 
 #include <vld.h>
 
@@ -16,6 +22,43 @@
 #define ARRAY_TESTS
 #ifdef ARRAY_TESTS
 
+/* Small deterministic LCG, so every run of the tests uses the same input */
+struct Lcg final
+{
+	uint32_t Seed;
+
+	uint32_t Next()
+	{
+		Seed = Seed * 1664525u + 1013904223u;
+		return Seed;
+	}
+};
+
+/* The sorting tests sort Records on Key, Order is the position before sorting so stability can be checked */
+struct Record final
+{
+	int Key;
+	int Order;
+};
+
+bool ByKey(const Record& a, const Record& b)
+{
+	return a.Key < b.Key;
+}
+
+bool IsSortedStably(const Array<Record>& records)
+{
+	for (uint64_t i{ 1 }; i < records.Size(); ++i)
+	{
+		if (records[i - 1].Key > records[i].Key)
+			return false;
+		if (records[i - 1].Key == records[i].Key && records[i - 1].Order > records[i].Order)
+			return false;
+	}
+
+	return true;
+}
+
 TEST_CASE("Testing Basic Array of integers")
 {
 	Array<int> arr{};
@@ -148,6 +191,8 @@ TEST_CASE("Testing Basic Array of integers")
 
 		REQUIRE(arr.Size() == nrOfElements + 1);
 		REQUIRE(arr[1] == 15);
+		REQUIRE(arr[2] == 1);
+		REQUIRE(arr.Back() == nrOfElements - 1);
 	}
 
 	SECTION("Making an array with non-trivial destructor type")
@@ -322,6 +367,9 @@ TEST_CASE("Testing Basic Array of integers")
 			REQUIRE(elem == counter++);
 		}
 
+		REQUIRE(arr.end() - arr.begin() == nrOfElements);
+		REQUIRE(arr.begin() - arr.end() == -nrOfElements);
+
 		arr.Clear();
 
 		for (int elem : arr)
@@ -475,6 +523,33 @@ TEST_CASE("Testing Basic Array of integers")
 		arr.EraseRange(3, 15); // should not crash
 
 		REQUIRE(arr.Size() == 3);
+
+		arr.Clear();
+
+		for (int i{}; i < nrOfElements; ++i)
+		{
+			arr.Add(i);
+		}
+
+		/* count is the number of erased elements, start + count is the first one kept */
+		arr.EraseRange(2, 3);
+
+		const Array<int> expected{ 0, 1, 5, 6, 7, 8, 9 };
+		REQUIRE(arr == expected);
+	}
+
+	SECTION("Removing every matching element in one pass")
+	{
+		for (int i{}; i < nrOfElements; ++i)
+		{
+			arr.Add(i % 4);
+		}
+
+		REQUIRE(arr.RemoveAll(0) == 3);
+		REQUIRE(arr.RemoveIf([](const int a)->bool { return a > 1; }) == 4);
+		REQUIRE(arr.Size() == 3);
+		REQUIRE(arr.Front() == 1);
+		REQUIRE(arr.Back() == 1);
 	}
 
 	SECTION("Popping off the front of the array")
@@ -568,6 +643,230 @@ TEST_CASE("Testing Basic Array of integers")
 			REQUIRE(arr[i] == list[i]);
 	}
 
+	SECTION("Sorting large arrays stably")
+	{
+		Array<Record> records{};
+		std::vector<int> list{};
+
+		Lcg rng{ 42u };
+		for (int i{}; i < 100'000; ++i)
+		{
+			const int key{ static_cast<int>(rng.Next() >> 20u) };
+
+			records.Add(Record{ key, i });
+			list.push_back(key);
+		}
+
+		records.Sort(ByKey);
+		std::sort(list.begin(), list.end());
+
+		bool bSameKeys{ true };
+		for (uint64_t i{}; i < records.Size(); ++i)
+			bSameKeys &= records[i].Key == list[i];
+
+		REQUIRE(bSameKeys);
+		REQUIRE(IsSortedStably(records));
+
+		Array<std::string> strings{};
+		for (int i{ 200 }; i > 0; --i)
+			strings.Add(std::to_string(i % 50));
+
+		strings.Sort();
+		REQUIRE(std::is_sorted(strings.begin(), strings.end()));
+	}
+
+	SECTION("Sorting from inside a predicate")
+	{
+		/* Bigger than any sort before it, so the inner sort cannot reuse the scratch space the outer sort is using */
+		Array<int> inner{};
+		for (int i{ 1'000'000 }; i > 0; --i)
+			inner.Add(i);
+
+		Array<std::string> outer{};
+		for (int i{ 1'000 }; i > 0; --i)
+			outer.Add(std::to_string(i));
+
+		/* The inner sort runs while the outer merge is still using its scratch space */
+		int nrOfCalls{};
+		outer.Sort([&inner, &nrOfCalls](const std::string& a, const std::string& b)->bool
+			{
+				if (++nrOfCalls == 5'000)
+					inner.Sort();
+
+				return a < b;
+			});
+
+		REQUIRE(std::is_sorted(outer.begin(), outer.end()));
+		REQUIRE(std::is_sorted(inner.begin(), inner.end()));
+		REQUIRE(outer.Size() == 1'000);
+	}
+
+	SECTION("Sorting adaptively")
+	{
+		Lcg rng{ 7u };
+		const auto next{ [&rng]()->int { return static_cast<int>(rng.Next() >> 22u); } };
+
+		Array<Record> records{};
+
+		/* Sorted, with an unsorted tail appended and a few elements swapped around */
+		for (int i{}; i < 50'000; ++i)
+			records.Add(Record{ i / 4, i });
+		for (int i{}; i < 1'000; ++i)
+			records.Add(Record{ next() * 16, 50'000 + i });
+		for (int i{}; i < 20; ++i)
+			std::swap(records[next() * 32], records[next() * 32]);
+
+		/* Order is the position before sorting, so stability can be checked */
+		for (uint64_t i{}; i < records.Size(); ++i)
+			records[i].Order = static_cast<int>(i);
+
+		records.Sort(ByKey, SortMode::Adaptive);
+		REQUIRE(IsSortedStably(records));
+
+		/* Descending runs, random data and many duplicates */
+		records.Clear();
+		for (int i{}; i < 30'000; ++i)
+			records.Add(Record{ (i % 3'000 < 1'500) ? 10'000 - i % 3'000 : next() % 16, i });
+
+		records.Sort(ByKey, SortMode::Adaptive);
+		REQUIRE(IsSortedStably(records));
+
+		Array<std::string> strings{};
+		for (int i{ 500 }; i > 0; --i)
+			strings.Add(std::to_string(i % 70 < 35 ? i : next()));
+
+		strings.Sort(SortMode::Adaptive);
+		REQUIRE(std::is_sorted(strings.begin(), strings.end()));
+	}
+
+	SECTION("Sorting unstably")
+	{
+		Lcg rng{ 11u };
+		const auto next{ [&rng]()->int { return static_cast<int>(rng.Next() >> 20u); } };
+
+		/* Random, sorted, reversed, many duplicates and an organ pipe, which trips up naive quicksorts */
+		for (int input{}; input < 5; ++input)
+		{
+			Array<int> values{};
+			std::vector<int> expected{};
+
+			for (int i{}; i < 20'000; ++i)
+			{
+				const int value{ input == 0 ? next() : input == 1 ? i : input == 2 ? -i : input == 3 ? next() % 4 : (i < 10'000 ? i : 20'000 - i) };
+
+				values.Add(value);
+				expected.push_back(value);
+			}
+
+			values.SortUnstable();
+			std::sort(expected.begin(), expected.end());
+
+			REQUIRE(values.Size() == expected.size());
+			REQUIRE(std::equal(values.begin(), values.end(), expected.begin()));
+
+			values.SortUnstable([](const int a, const int b)->bool { return a > b; });
+			REQUIRE(std::is_sorted(values.begin(), values.end(), std::greater<int>{}));
+		}
+
+		Array<std::string> strings{};
+		for (int i{ 2'000 }; i > 0; --i)
+			strings.Add(std::to_string(next() % 300));
+
+		strings.SortUnstable();
+		REQUIRE(std::is_sorted(strings.begin(), strings.end()));
+	}
+
+	SECTION("Sorting with a radix sort")
+	{
+		Lcg rng{ 13u };
+		const auto next{ [&rng]()->uint32_t { return rng.Next(); } };
+
+		Array<int> values{};
+		Array<float> floats{};
+		Array<uint64_t> bigValues{};
+
+		for (int i{}; i < 20'000; ++i)
+		{
+			values.Add(static_cast<int>(next()));
+			floats.Add(static_cast<float>(static_cast<int>(next() % 2'001u) - 1'000) / 7.f);
+			bigValues.Add((static_cast<uint64_t>(next()) << 32u) | (i % 2 == 0 ? next() : 0u));
+		}
+
+		values.RadixSort();
+		floats.RadixSort();
+		bigValues.RadixSort();
+
+		REQUIRE(std::is_sorted(values.begin(), values.end()));
+		REQUIRE(std::is_sorted(floats.begin(), floats.end()));
+		REQUIRE(std::is_sorted(bigValues.begin(), bigValues.end()));
+
+		/* Only the low byte differs, so most passes get skipped */
+		Array<uint32_t> smallValues{};
+		for (uint32_t i{}; i < 1'000u; ++i)
+			smallValues.Add(next() % 200u);
+
+		smallValues.RadixSort();
+		REQUIRE(std::is_sorted(smallValues.begin(), smallValues.end()));
+
+		Array<Record> records{};
+		for (int i{}; i < 5'000; ++i)
+			records.Add(Record{ static_cast<int>(next() % 100u) - 50, i });
+
+		/* Radix sort is stable, so records with the same key keep the order they were added in */
+		records.RadixSort([](const Record& record)->int16_t { return static_cast<int16_t>(record.Key); });
+		REQUIRE(IsSortedStably(records));
+
+		/* Elements that have to be destroyed go through the sort's buffer as well */
+		Array<std::string> names{};
+		for (int i{}; i < 1'000; ++i)
+			names.Add(std::string(32, static_cast<char>('a' + next() % 26u)));
+
+		names.RadixSort([](const std::string& name)->char { return name[0]; });
+		REQUIRE(std::is_sorted(names.begin(), names.end()));
+
+		/* A throwing keyOf in the middle of a pass must not leave elements behind in the sort's buffer */
+		int nrOfKeys{};
+		REQUIRE_THROWS_AS(names.RadixSort([&nrOfKeys](const std::string& name)->char
+			{
+				if (++nrOfKeys == 1'500)
+					throw std::runtime_error{ "keyOf" };
+
+				return name[0];
+			}), std::runtime_error);
+		REQUIRE(names.Size() == 1'000);
+	}
+
+	SECTION("Sorting in parallel")
+	{
+		Lcg rng{ 17u };
+		const auto next{ [&rng]()->int { return static_cast<int>(rng.Next() >> 8u); } };
+
+		/* An odd amount of threads leaves a run without partner every round */
+		for (const uint64_t nrOfThreads : { 1u, 2u, 3u, 4u })
+		{
+			ThreadPool pool{ nrOfThreads };
+
+			Array<Record> records{};
+			for (int i{}; i < 100'000; ++i)
+				records.Add(Record{ next() % 1'000, i });
+
+			records.ParallelSort(ByKey, pool);
+			REQUIRE(IsSortedStably(records));
+		}
+
+		Array<std::string> strings{};
+		for (int i{}; i < 70'000; ++i)
+			strings.Add(std::to_string(next()));
+
+		strings.ParallelSort();
+		REQUIRE(std::is_sorted(strings.begin(), strings.end()));
+
+		/* Too small to be worth the threads */
+		Array<int> values{ 5, 3, 9, 1 };
+		values.ParallelSort();
+		REQUIRE(std::is_sorted(values.begin(), values.end()));
+	}
+
 	SECTION("Sorting an array using Merge Sort with specified predicate (when array size > 64)")
 	{
 		std::vector<int> list{};
@@ -600,41 +899,1941 @@ TEST_CASE("Testing Basic Array of integers")
 	}
 }
 
-#include <string>
-TEST_CASE("Testing Basic Array of characters")
+#include <memory_resource>
+template<typename T>
+struct CountingAllocator final
 {
-	Array<char> arr{};
+	using value_type = T;
 
-	SECTION("Adding characters")
+	CountingAllocator(uint64_t* pNrOfAllocations)
+		: pAllocations{ pNrOfAllocations }
+	{}
+	template<typename U>
+	CountingAllocator(const CountingAllocator<U>& other)
+		: pAllocations{ other.pAllocations }
+	{}
+
+	T* allocate(const size_t n)
 	{
-		const std::string letters{ "abcdefgh" };
+		++(*pAllocations);
+		return std::allocator<T>{}.allocate(n);
+	}
+	void deallocate(T* p, const size_t n)
+	{
+		std::allocator<T>{}.deallocate(p, n);
+	}
 
-		for (const char c : letters)
-			arr.Add(c);
+	bool operator==(const CountingAllocator& other) const { return pAllocations == other.pAllocations; }
+	bool operator!=(const CountingAllocator& other) const { return pAllocations != other.pAllocations; }
 
-		for (size_t i{}; i < arr.Size(); ++i)
-			REQUIRE(arr[i] == letters[i]);
+	uint64_t* pAllocations;
+};
+
+TEST_CASE("Testing Array with custom allocators")
+{
+	const int nrOfElements{ 10 };
+
+	SECTION("All memory goes through the allocator")
+	{
+		uint64_t nrOfAllocations{};
+
+		Array<int, CountingAllocator<int>> arr{ CountingAllocator<int>{ &nrOfAllocations } };
+
+		arr.Reserve(nrOfElements);
+		REQUIRE(nrOfAllocations == 1);
+
+		for (int i{}; i < nrOfElements; ++i)
+			arr.Add(i);
+
+		REQUIRE(nrOfAllocations == 1);
+
+		Array<int, CountingAllocator<int>> newArr{ arr };
+		REQUIRE(nrOfAllocations == 2);
+		REQUIRE(newArr == arr);
+
+		Array<int, CountingAllocator<int>> selected{ arr.Select([](const int a)->bool { return a > 5; }) };
+		REQUIRE(nrOfAllocations == 3);
+		REQUIRE(selected.GetAllocator() == arr.GetAllocator());
 	}
 
-	SECTION("Adding Character to the front")
+	SECTION("Using a polymorphic memory resource")
 	{
-		const std::string letters{ "abcdefgh" };
+		std::pmr::monotonic_buffer_resource resource{};
 
-		for (const char c : letters)
-			arr.AddFront(c);
+		PmrArray<int> arr{ &resource };
 
-		size_t counter{};
-		for (int i{ static_cast<int>(arr.Size() - 1) }; i >= 0; --i)
-			REQUIRE(letters[i] == arr[counter++]);
+		for (int i{}; i < nrOfElements; ++i)
+			arr.Add(i);
+
+		REQUIRE(arr.Size() == nrOfElements);
+		REQUIRE(arr.GetAllocator().resource() == &resource);
+
+		PmrArray<int> newArr{ std::pmr::new_delete_resource() };
+		newArr = __MOVE(arr);
+
+		REQUIRE(newArr.Size() == nrOfElements);
+		REQUIRE(newArr.GetAllocator().resource() == std::pmr::new_delete_resource());
+
+		for (int i{}; i < nrOfElements; ++i)
+			REQUIRE(newArr[i] == i);
 	}
 }
-#endif // ARRAY_TESTS
 
-#else
-#define STL
-//#define CUSTOM
-int main(int argc, char* argv[])
+struct LifetimeCounter final
+{
+	inline static int NrOfConstructions{};
+	inline static int NrOfDestructions{};
+
+	LifetimeCounter() : Value{} { ++NrOfConstructions; }
+	LifetimeCounter(const int val) : Value{ val } { ++NrOfConstructions; }
+	LifetimeCounter(const LifetimeCounter& other) : Value{ other.Value } { ++NrOfConstructions; }
+	LifetimeCounter(LifetimeCounter&& other) noexcept : Value{ other.Value } { ++NrOfConstructions; }
+	LifetimeCounter& operator=(const LifetimeCounter&) = default;
+	LifetimeCounter& operator=(LifetimeCounter&&) noexcept = default;
+	~LifetimeCounter() { ++NrOfDestructions; }
+
+	static int Alive() { return NrOfConstructions - NrOfDestructions; }
+
+	bool operator==(const LifetimeCounter& other) const { return Value == other.Value; }
+	bool operator!=(const LifetimeCounter& other) const { return Value != other.Value; }
+	bool operator<(const LifetimeCounter& other) const { return Value < other.Value; }
+
+	int Value;
+};
+
+/* Copying throws once CopiesBeforeThrow more copies have been made, a negative count never throws.
+   Text is too long for the small string buffer, so a slot that gets destroyed twice or never shows up */
+struct ThrowingCopy final
+{
+	inline static int CopiesBeforeThrow{ -1 };
+	inline static int NrAlive{};
+
+	ThrowingCopy(const int val) : Value{ val }, Text(32, 'a') { ++NrAlive; }
+	ThrowingCopy(const ThrowingCopy& other)
+		: Value{ other.Value }
+		, Text{ other.Text }
+	{
+		if (CopiesBeforeThrow >= 0 && CopiesBeforeThrow-- == 0)
+			throw std::runtime_error{ "ThrowingCopy" };
+
+		++NrAlive;
+	}
+	ThrowingCopy(ThrowingCopy&& other) noexcept : Value{ other.Value }, Text{ __MOVE(other.Text) } { ++NrAlive; }
+	ThrowingCopy& operator=(const ThrowingCopy&) = default;
+	ThrowingCopy& operator=(ThrowingCopy&&) noexcept = default;
+	~ThrowingCopy() { --NrAlive; }
+
+	int Value;
+	std::string Text;
+};
+
+TEST_CASE("Testing Array element lifetimes")
 {
+	const int nrOfElements{ 10 };
+	const int aliveAtStart{ LifetimeCounter::Alive() };
+
+	SECTION("Only live elements are constructed")
+	{
+		Array<LifetimeCounter> arr{};
+
+		arr.Reserve(100);
+		REQUIRE(LifetimeCounter::Alive() == aliveAtStart);
+
+		for (int i{}; i < nrOfElements; ++i)
+			arr.Add(i);
+
+		REQUIRE(LifetimeCounter::Alive() == aliveAtStart + nrOfElements);
+
+		arr.ShrinkToFit();
+		REQUIRE(LifetimeCounter::Alive() == aliveAtStart + nrOfElements);
+
+		arr.Insert(4, 15);
+		arr.AddFront(16);
+		arr.PopFront();
+		arr.Erase(2);
+		arr.Pop();
+		REQUIRE(LifetimeCounter::Alive() == aliveAtStart + nrOfElements - 1);
+		REQUIRE(arr[3] == 15);
+		REQUIRE(arr[4] == 4);
+		REQUIRE(arr.Back() == 8);
+
+		arr.Clear();
+		REQUIRE(LifetimeCounter::Alive() == aliveAtStart);
+	}
+
+	SECTION("Erasing by position and by range")
+	{
+		Array<LifetimeCounter> arr{};
+
+		for (int i{}; i < nrOfElements; ++i)
+			arr.Add(i % 2);
+
+		/* Erasing through an iterator removes that element, not the first one equal to it */
+		arr.Erase(arr.begin() + 3);
+		REQUIRE(arr.Size() == nrOfElements - 1);
+		REQUIRE(arr[1] == 1);
+		REQUIRE(arr[3] == 0);
+
+		arr.EraseRange(2, 4);
+		REQUIRE(arr.Size() == nrOfElements - 5);
+		REQUIRE(LifetimeCounter::Alive() == aliveAtStart + nrOfElements - 5);
+		REQUIRE(arr[2] == 1);
+
+		arr.EraseRange(arr.begin() + 1, arr.end());
+		REQUIRE(arr.Size() == 1);
+		REQUIRE(LifetimeCounter::Alive() == aliveAtStart + 1);
+	}
+
+	SECTION("Removing every matching element")
+	{
+		Array<LifetimeCounter> arr{};
+
+		for (int i{}; i < nrOfElements; ++i)
+			arr.Add(i);
+
+		REQUIRE(arr.RemoveIf([](const LifetimeCounter& elem)->bool { return elem.Value % 3 == 0; }) == 4);
+		REQUIRE(arr.Size() == nrOfElements - 4);
+		REQUIRE(LifetimeCounter::Alive() == aliveAtStart + nrOfElements - 4);
+		REQUIRE(arr[0] == 1);
+		REQUIRE(arr[2] == 4);
+		REQUIRE(arr.Back() == 8);
+
+		arr.Add(arr.Front());
+		REQUIRE(arr.RemoveAll(arr.Front()) == 2);
+		REQUIRE(arr.Front() == 2);
+		REQUIRE(arr.RemoveAll(LifetimeCounter{ 100 }) == 0);
+	}
+
+	SECTION("Erasing without keeping the order")
+	{
+		Array<LifetimeCounter> arr{};
+
+		for (int i{}; i < nrOfElements; ++i)
+			arr.Add(i);
+
+		arr.EraseUnordered(2);
+		REQUIRE(arr[2] == 9);
+		REQUIRE(arr.Back() == 8);
+
+		arr.EraseUnordered(arr.Find(8));
+		REQUIRE(arr.Back() == 7);
+
+		arr.EraseUnordered(LifetimeCounter{ 0 });
+		REQUIRE(arr.Front() == 7);
+		REQUIRE(arr.Size() == nrOfElements - 3);
+
+		REQUIRE(arr.RemoveIfUnordered([](const LifetimeCounter& elem)->bool { return elem.Value % 2 == 1; }) == 5);
+		REQUIRE(arr.Size() == 2);
+		REQUIRE(LifetimeCounter::Alive() == aliveAtStart + 2);
+		REQUIRE(arr.Find(LifetimeCounter{ 4 }) != arr.end());
+		REQUIRE(arr.Find(LifetimeCounter{ 6 }) != arr.end());
+	}
+
+	SECTION("Resetting while keeping the objects alive")
+	{
+		Array<LifetimeCounter> arr{};
+
+		for (int i{}; i < nrOfElements; ++i)
+			arr.Add(i);
+
+		const int constructionsBefore{ LifetimeCounter::NrOfConstructions };
+
+		arr.ResetKeepObjects();
+		REQUIRE(arr.Empty());
+		REQUIRE(LifetimeCounter::Alive() == aliveAtStart + nrOfElements);
+
+		/* Both reuse the objects instead of constructing new ones */
+		arr.Add(LifetimeCounter{ 42 });
+		REQUIRE(arr.Reacquire().Value == 1);
+		REQUIRE(LifetimeCounter::NrOfConstructions == constructionsBefore + 1);
+		REQUIRE(arr.Front() == 42);
+		REQUIRE(arr.Size() == 2);
+
+		/* Popping destroys only the popped element, the recycled objects stay */
+		arr.Pop();
+		REQUIRE(LifetimeCounter::Alive() == aliveAtStart + nrOfElements - 1);
+
+		const int constructionsBeforeReuse{ LifetimeCounter::NrOfConstructions };
+
+		arr.ResetKeepObjects();
+		for (int i{}; i < 5; ++i)
+			arr.Reacquire();
+
+		REQUIRE(LifetimeCounter::NrOfConstructions == constructionsBeforeReuse);
+		REQUIRE(arr.Size() == 5);
+		REQUIRE(arr.Front() == 42);
+	}
+
+	SECTION("Adding something other than a T constructs over a recycled object")
+	{
+		struct Tagged final
+		{
+			Tagged(const int val) : Value{ val }, bConstructed{ true } {}
+			Tagged& operator=(const int val) { Value = val; bConstructed = false; return *this; }
+			~Tagged() {}
+
+			int Value;
+			bool bConstructed;
+		};
+
+		Array<Tagged> arr{};
+		arr.EmplaceBack(1);
+		arr.EmplaceBack(2);
+
+		arr.ResetKeepObjects();
+		arr.EmplaceBack(3);
+		arr.Add(Tagged{ 4 });
+
+		REQUIRE(arr[0].Value == 3);
+		REQUIRE(arr[0].bConstructed);
+		REQUIRE(arr[1].Value == 4);
+	}
+
+	SECTION("Erasing and inserting keep the recycled objects alive")
+	{
+		Array<LifetimeCounter> arr{};
+
+		for (int i{}; i < nrOfElements; ++i)
+			arr.Add(i);
+
+		arr.ResetKeepObjects();
+		for (int i{}; i < 5; ++i)
+			arr.Reacquire();
+
+		arr.EraseByIndex(2u);
+		arr.EraseRange(0u, 2u);
+		REQUIRE(arr.RemoveIf([](const LifetimeCounter& elem)->bool { return elem.Value == 3; }) == 1u);
+		REQUIRE(arr.Size() == 1);
+		REQUIRE(LifetimeCounter::Alive() == aliveAtStart + 6);
+
+		/* Inserting in the middle shifts an element onto one recycled object, only that one is destroyed */
+		arr.Insert(0u, LifetimeCounter{ 100 });
+		arr.Insert(1u, LifetimeCounter{ 101 });
+		REQUIRE(arr.Size() == 3);
+		REQUIRE(arr[0] == 100);
+		REQUIRE(arr[1] == 101);
+		REQUIRE(arr[2] == 4);
+		REQUIRE(LifetimeCounter::Alive() == aliveAtStart + 7);
+
+		const int constructionsBefore{ LifetimeCounter::NrOfConstructions };
+
+		for (int i{}; i < 4; ++i)
+			arr.Reacquire();
+
+		REQUIRE(LifetimeCounter::NrOfConstructions == constructionsBefore);
+		REQUIRE(arr.Size() == 7);
+		REQUIRE(LifetimeCounter::Alive() == aliveAtStart + 7);
+	}
+
+	SECTION("Refilling an Array of strings keeps their buffers")
+	{
+		Array<std::string> strings{};
+
+		for (int i{}; i < 10; ++i)
+			strings.Add(std::string(100, 'a'));
+
+		const char* const pFirstBuffer{ strings.Front().data() };
+
+		strings.ResetKeepObjects();
+		strings.Add("b");
+
+		REQUIRE(strings.Size() == 1);
+		REQUIRE(strings.Front() == "b");
+		REQUIRE(strings.Front().data() == pFirstBuffer);
+
+		strings.AddRange({ "c", "d" });
+		REQUIRE(strings.Size() == 3);
+		REQUIRE(strings.Back() == "d");
+		REQUIRE(strings.Back().capacity() >= 100u);
+	}
+
+	SECTION("Destroying an array destroys every element exactly once")
+	{
+		{
+			Array<LifetimeCounter> arr{ 10_size };
+			Array<LifetimeCounter> newArr{ arr };
+
+			REQUIRE(LifetimeCounter::Alive() == aliveAtStart + 2 * nrOfElements);
+		}
+
+		REQUIRE(LifetimeCounter::Alive() == aliveAtStart);
+	}
+}
+
+struct RelocatableHolder final
+{
+	std::unique_ptr<int> pValue;
+};
+template<>
+struct IsTriviallyRelocatable<RelocatableHolder> : std::true_type {};
+
+TEST_CASE("Testing trivially relocatable elements")
+{
+	Array<RelocatableHolder> arr{};
+
+	for (int i{}; i < 100; ++i)
+		arr.Add(RelocatableHolder{ std::make_unique<int>(i) });
+
+	arr.AddFront(RelocatableHolder{ std::make_unique<int>(-1) });
+	arr.Insert(50, RelocatableHolder{ std::make_unique<int>(-2) });
+	arr.EraseByIndex(10);
+	arr.PopFront();
+
+	REQUIRE(arr.Size() == 100);
+	REQUIRE(*arr[0].pValue == 0);
+	REQUIRE(*arr[9].pValue == 10);
+	REQUIRE(*arr[48].pValue == -2);
+	REQUIRE(*arr.Back().pValue == 99);
+}
+
+TEST_CASE("Testing Array growing in place")
+{
+	Array<int, ReallocAllocator<int>> arr{};
+
+	SECTION("Growing through realloc and mremap")
+	{
+		const int nrOfElements{ static_cast<int>(2 * ReallocAllocator<int>::MmapThreshold / sizeof(int)) };
+
+		for (int i{}; i < nrOfElements; ++i)
+			arr.Add(i);
+
+		REQUIRE(arr.Size() == nrOfElements);
+
+		bool bAllEqual{ true };
+		for (int i{}; i < nrOfElements; ++i)
+			bAllEqual &= arr[i] == i;
+
+		REQUIRE(bAllEqual);
+
+		arr.Resize(100);
+		arr.ShrinkToFit();
+
+		REQUIRE(arr.Capacity() == 100);
+		REQUIRE(arr.Back() == 99);
+	}
+
+	SECTION("Shrinking an emptied array")
+	{
+		for (int i{}; i < 10; ++i)
+			arr.Add(i);
+
+		arr.Clear();
+		arr.ShrinkToFit();
+
+		REQUIRE(arr.Capacity() == 0);
+		REQUIRE(arr.Empty());
+
+		arr.Add(5);
+		REQUIRE(arr.Front() == 5);
+	}
+}
+
+TEST_CASE("Testing Array growth policies")
+{
+	SECTION("Policies always make room for the requested capacity")
+	{
+		REQUIRE(OneAndAHalfGrowth::CalculateNewCapacity(0, 1, sizeof(int)) == 1);
+		REQUIRE(OneAndAHalfGrowth::CalculateNewCapacity(10, 11, sizeof(int)) == 15);
+		REQUIRE(DoubleGrowth::CalculateNewCapacity(10, 11, sizeof(int)) == 20);
+		REQUIRE(GoldenRatioGrowth::CalculateNewCapacity(1000, 1001, sizeof(int)) == 1618);
+		REQUIRE(DoubleGrowth::CalculateNewCapacity(10, 100, sizeof(int)) == 100);
+		REQUIRE(DoubleGrowth::CalculateNewCapacity(std::numeric_limits<uint64_t>::max() - 1, std::numeric_limits<uint64_t>::max(), 1)
+			== std::numeric_limits<uint64_t>::max());
+	}
+
+	SECTION("Rounding policies fill up pages and size classes")
+	{
+		REQUIRE(PageRoundedGrowth<4096>::CalculateNewCapacity(1000, 1001, sizeof(int)) * sizeof(int) == 8192);
+		REQUIRE(PageRoundedGrowth<4096>::CalculateNewCapacity(10, 11, sizeof(int)) == 15);
+
+		const uint64_t newCap{ SizeClassGrowth<>::CalculateNewCapacity(10, 11, sizeof(int)) };
+		REQUIRE(newCap >= 15);
+		REQUIRE(MallocSizeClasses::RoundUp(newCap * sizeof(int)) == newCap * sizeof(int));
+	}
+
+	SECTION("Using a growth policy on an array")
+	{
+		Array<int, std::allocator<int>, DoubleGrowth> arr{};
+
+		arr.Add(0);
+		arr.Add(1);
+		arr.Add(2);
+		REQUIRE(arr.Capacity() == 4);
+
+		arr.Add(3);
+		arr.Add(4);
+		REQUIRE(arr.Capacity() == 8);
+	}
+}
+
+TEST_CASE("Testing SmallArray")
+{
+	uint64_t nrOfAllocations{};
+	SmallArray<int, 8, CountingAllocator<int>> arr{ CountingAllocator<int>{ &nrOfAllocations } };
+
+	REQUIRE(arr.Capacity() == 8);
+	REQUIRE(arr.Empty());
+
+	SECTION("Elements are stored inline until the array grows beyond N")
+	{
+		for (int i{}; i < 8; ++i)
+			arr.Add(i);
+
+		REQUIRE(nrOfAllocations == 0);
+		REQUIRE(reinterpret_cast<const char*>(arr.Data()) >= reinterpret_cast<const char*>(&arr));
+		REQUIRE(reinterpret_cast<const char*>(arr.Data()) < reinterpret_cast<const char*>(&arr + 1));
+
+		arr.Add(8);
+
+		REQUIRE(nrOfAllocations == 1);
+		REQUIRE(arr.Capacity() > 8);
+
+		for (int i{}; i < 9; ++i)
+			REQUIRE(arr[i] == i);
+
+		arr.Resize(4);
+		arr.ShrinkToFit();
+
+		REQUIRE(arr.Capacity() == 8);
+		REQUIRE(arr.Back() == 3);
+	}
+
+	SECTION("Copying and moving inline and heap arrays")
+	{
+		const int aliveAtStart{ LifetimeCounter::Alive() };
+
+		{
+			SmallArray<LifetimeCounter, 4> small{};
+			small.Add(1);
+			small.Add(2);
+
+			SmallArray<LifetimeCounter, 4> copy{ small };
+			SmallArray<LifetimeCounter, 4> moved{ __MOVE(small) };
+
+			REQUIRE(small.Empty());
+			REQUIRE(copy == moved);
+			REQUIRE(moved.Capacity() == 4);
+
+			for (int i{}; i < 10; ++i)
+				copy.Add(i);
+
+			moved = copy;
+			REQUIRE(moved == copy);
+
+			small = __MOVE(copy);
+			REQUIRE(small == moved);
+			REQUIRE(copy.Empty());
+
+			moved.Clear();
+			moved.Add(5);
+			small = __MOVE(moved);
+			REQUIRE(small.Size() == 1);
+			REQUIRE(small[0] == 5);
+		}
+
+		REQUIRE(LifetimeCounter::Alive() == aliveAtStart);
+	}
+}
+
+#include <string>
+constexpr int SumOfSortedInplaceArray()
+{
+	InplaceArray<int, 8> arr{ 5, 3, 4, 9 };
+	arr.Add(1);
+	arr.Insert(0, 7);
+	arr.Erase(4);
+	arr.Sort();
+
+	int sum{};
+	for (const int elem : arr)
+		sum = sum * 10 + elem;
+
+	return sum;
+}
+
+TEST_CASE("Testing InplaceArray")
+{
+	static_assert(SumOfSortedInplaceArray() == 13579);
+	static_assert(std::is_trivially_copyable_v<InplaceArray<int, 8>>);
+	static_assert(!std::is_trivially_copyable_v<InplaceArray<std::string, 8>>);
+
+	InplaceArray<int, 10> arr{};
+
+	REQUIRE(arr.Capacity() == 10);
+	REQUIRE(arr.Empty());
+
+	SECTION("Running out of capacity is reported")
+	{
+		for (int i{}; i < 10; ++i)
+			REQUIRE(arr.TryAdd(i));
+
+		REQUIRE(arr.Full());
+		REQUIRE(!arr.TryAdd(10));
+		REQUIRE(arr.TryEmplaceBack(10) == nullptr);
+		REQUIRE(arr.Size() == 10);
+		REQUIRE(arr.Back() == 9);
+
+		/* The regular functions throw, in release builds as well */
+		REQUIRE_THROWS_AS(arr.Add(10), std::bad_alloc);
+		REQUIRE_THROWS_AS(arr.Emplace(0, 10), std::bad_alloc);
+		REQUIRE_THROWS_AS(arr.Resize(11), std::bad_alloc);
+		REQUIRE(arr.Size() == 10);
+
+		arr.Clear();
+		REQUIRE_THROWS_AS(arr.AddRange({ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 }), std::bad_alloc);
+		REQUIRE(arr.Empty());
+
+		REQUIRE_THROWS_AS((InplaceArray<int, 10>{ 11_size }), std::bad_alloc);
+
+		/* Ranges are checked before anything gets added */
+		InplaceArray<int, 10> eight{ 0, 1, 2, 3, 4, 5, 6, 7 };
+		arr.AddRange({ 0, 1, 2, 3, 4 });
+		REQUIRE_THROWS_AS(arr.AddRange(eight.begin(), eight.end()), std::bad_alloc);
+		REQUIRE(arr.Size() == 5);
+	}
+
+	SECTION("Emplacing one of our own elements or a throwing copy")
+	{
+		InplaceArray<std::string, 10> strings{ std::string(32, 'a'), std::string(32, 'b'), std::string(32, 'c') };
+
+		strings.Emplace(0, strings[2]);
+		REQUIRE(strings.Size() == 4);
+		REQUIRE(strings[0] == std::string(32, 'c'));
+		REQUIRE(strings[3] == std::string(32, 'c'));
+
+		{
+			InplaceArray<ThrowingCopy, 4> throwing{};
+			throwing.Add(ThrowingCopy{ 0 });
+			throwing.Add(ThrowingCopy{ 1 });
+
+			const ThrowingCopy val{ 42 };
+
+			ThrowingCopy::CopiesBeforeThrow = 0;
+			REQUIRE_THROWS_AS(throwing.Add(val), std::runtime_error);
+
+			ThrowingCopy::CopiesBeforeThrow = 0;
+			REQUIRE_THROWS_AS(throwing.Emplace(0, val), std::runtime_error);
+
+			ThrowingCopy::CopiesBeforeThrow = -1;
+
+			REQUIRE(throwing.Size() == 2);
+			REQUIRE(throwing[0].Value == 0);
+			REQUIRE(throwing[1].Value == 1);
+			REQUIRE(ThrowingCopy::NrAlive == 2 + 1);
+		}
+
+		REQUIRE(ThrowingCopy::NrAlive == 0);
+	}
+
+	SECTION("Using the Array API")
+	{
+		arr.AddRange({ 5, 0, 3, 6, 7, 15, 356, -5 });
+
+		REQUIRE(*arr.Find(6) == 6);
+		REQUIRE(arr.Find(-1) == arr.end());
+
+		arr.Erase(arr.Find(0));
+		arr.EraseByIndex(0);
+		REQUIRE(arr.Front() == 3);
+		REQUIRE(arr.Size() == 6);
+
+		InplaceArray<int, 10> selected{ arr.Select([](const int a)->bool { return a > 5; }) };
+		REQUIRE(selected.Size() == 4);
+
+		arr.Sort();
+		for (uint64_t i{ 1 }; i < arr.Size(); ++i)
+			REQUIRE(arr[i - 1] <= arr[i]);
+
+		arr.EraseRange(1, 100);
+		REQUIRE(arr.Size() == 1);
+		REQUIRE(arr.Front() == -5);
+	}
+
+	SECTION("Storing non-trivial types")
+	{
+		const int aliveAtStart{ LifetimeCounter::Alive() };
+
+		{
+			InplaceArray<LifetimeCounter, 4> counters{};
+			counters.Add(1);
+			counters.Add(2);
+			counters.AddFront(0);
+
+			InplaceArray<LifetimeCounter, 4> copy{ counters };
+			counters.PopFront();
+
+			REQUIRE(copy.Size() == 3);
+			REQUIRE(counters.Front() == 1);
+
+			counters = __MOVE(copy);
+			REQUIRE(counters.Size() == 3);
+			REQUIRE(copy.Empty());
+		}
+
+		REQUIRE(LifetimeCounter::Alive() == aliveAtStart);
+	}
+}
+
+TEST_CASE("Testing Array with an arena allocator")
+{
+	Arena arena{ 1024 };
+
+	SECTION("Growing the last allocation happens in place")
+	{
+		Array<int, ArenaAllocator<int>> arr{ ArenaAllocator<int>{ &arena } };
+
+		arr.Add(0);
+		const int* const pData{ arr.Data() };
+
+		for (int i{ 1 }; i < 100; ++i)
+			arr.Add(i);
+
+		REQUIRE(arr.Data() == pData);
+		REQUIRE(arr.Back() == 99);
+	}
+
+	SECTION("Shrinking an older allocation keeps it in place")
+	{
+		Array<int, ArenaAllocator<int>> arr{ ArenaAllocator<int>{ &arena } };
+
+		for (int i{}; i < 100; ++i)
+			arr.Add(i);
+
+		/* arr is no longer the last allocation of the arena */
+		Array<int, ArenaAllocator<int>> other{ ArenaAllocator<int>{ &arena } };
+		other.Add(0);
+
+		const int* const pData{ arr.Data() };
+		const uint64_t usedBytes{ arena.GetUsedBytesInBlock() };
+
+		arr.Resize(10);
+		arr.ShrinkToFit();
+
+		REQUIRE(arr.Data() == pData);
+		REQUIRE(arena.GetUsedBytesInBlock() == usedBytes);
+		REQUIRE(arr.Back() == 9);
+	}
+
+	SECTION("Results of Select and FindAll come from the same arena")
+	{
+		Array<int, ArenaAllocator<int>> arr{ ArenaAllocator<int>{ &arena } };
+
+		for (int i{}; i < 1000; ++i)
+			arr.Add(i % 10);
+
+		Array<int, ArenaAllocator<int>> fives{ arr.FindAll(5) };
+		Array<int, ArenaAllocator<int>> large{ arr.Select([](const int a)->bool { return a > 7; }) };
+
+		REQUIRE(fives.Size() == 100);
+		REQUIRE(large.Size() == 200);
+		REQUIRE(fives.GetAllocator() == arr.GetAllocator());
+		REQUIRE(large.GetAllocator().GetArena() == &arena);
+	}
+
+	SECTION("Resetting the arena reuses its memory")
+	{
+		const void* pFirst{};
+
+		for (int frame{}; frame < 3; ++frame)
+		{
+			{
+				Array<uint64_t, ArenaAllocator<uint64_t>> arr{ ArenaAllocator<uint64_t>{ &arena } };
+
+				for (uint64_t i{}; i < 10'000; ++i)
+					arr.Add(i);
+
+				if (frame == 0)
+					pFirst = arr.Data();
+
+				REQUIRE(arr.Data() == pFirst);
+			}
+
+			arena.Reset();
+			REQUIRE(arena.GetUsedBytesInBlock() == 0);
+		}
+	}
+}
+
+TEST_CASE("Testing Array with a pool allocator")
+{
+	SECTION("Freed buffers get recycled")
+	{
+		const int* pData{};
+
+		{
+			Array<int, PoolAllocator<int>> arr{ 100_capacity };
+			pData = arr.Data();
+		}
+
+		Array<int, PoolAllocator<int>> arr{ 120_capacity };
+		REQUIRE(arr.Data() == pData);
+	}
+
+	SECTION("Growing to the pool's size classes")
+	{
+		Array<int, PoolAllocator<int>, SizeClassGrowth<BufferPool>> arr{};
+
+		for (int i{}; i < 1000; ++i)
+		{
+			arr.Add(i);
+
+			REQUIRE(BufferPool::RoundUp(arr.Capacity() * sizeof(int)) == arr.Capacity() * sizeof(int));
+		}
+
+		for (int i{}; i < 1000; ++i)
+			REQUIRE(arr[i] == i);
+	}
+
+	SECTION("Using the pool from several threads")
+	{
+		std::vector<std::thread> threads{};
+
+		for (int t{}; t < 4; ++t)
+		{
+			threads.emplace_back([]()
+				{
+					for (int i{}; i < 200; ++i)
+					{
+						Array<uint64_t, PoolAllocator<uint64_t>> arr{};
+
+						for (uint64_t j{}; j < static_cast<uint64_t>(i) * 10u; ++j)
+							arr.Add(j);
+
+						arr.ShrinkToFit();
+					}
+				});
+		}
+
+		for (std::thread& thread : threads)
+			thread.join();
+	}
+}
+
+TEST_CASE("Testing aligned Arrays")
+{
+	SECTION("Data() stays aligned when reallocating")
+	{
+		AlignedArray<float, 64> arr{};
+
+		for (int i{}; i < 1000; ++i)
+		{
+			arr.Add(static_cast<float>(i));
+
+			REQUIRE(reinterpret_cast<uintptr_t>(arr.Data()) % 64 == 0);
+		}
+
+		arr.ShrinkToFit();
+		REQUIRE(reinterpret_cast<uintptr_t>(arr.Data()) % 64 == 0);
+	}
+
+	SECTION("Data() stays aligned when adding and removing anywhere")
+	{
+		AlignedArray<float, 64> arr{};
+
+		for (int i{}; i < 100; ++i)
+			arr.Add(static_cast<float>(i));
+
+		const auto isAligned{ [&arr]()->bool { return reinterpret_cast<uintptr_t>(arr.Data()) % 64 == 0; } };
+
+		arr.EraseByIndex(3);
+		REQUIRE(isAligned());
+
+		arr.Insert(5, -1.f);
+		REQUIRE(isAligned());
+
+		arr.PopFront();
+		REQUIRE(isAligned());
+		REQUIRE(arr.Front() == 1.f);
+
+		arr.AddFront(-2.f);
+		REQUIRE(isAligned());
+		REQUIRE(arr.Front() == -2.f);
+
+		arr.EraseRange(0, 3);
+		REQUIRE(isAligned());
+		REQUIRE(arr.Front() == 4.f);
+
+		const float values[]{ 7.f, 8.f, 9.f };
+		arr.InsertRange(0, values, 3);
+		REQUIRE(isAligned());
+		REQUIRE(arr.Front() == 7.f);
+		REQUIRE(arr.Size() == 100);
+	}
+
+	SECTION("Large blocks are aligned to huge pages")
+	{
+		using Allocator = HugePageAllocator<uint64_t, 32, true>;
+
+		Array<uint64_t, Allocator> arr{ 16_capacity };
+		REQUIRE(reinterpret_cast<uintptr_t>(arr.Data()) % 32 == 0);
+
+		arr.Reserve(Allocator::HugePageSize);
+#ifdef __linux__
+		REQUIRE(reinterpret_cast<uintptr_t>(arr.Data()) % Allocator::HugePageSize == 0);
+#endif
+
+		for (uint64_t i{}; i < Allocator::HugePageSize; ++i)
+			arr.Add(i);
+
+		REQUIRE(arr.Back() == Allocator::HugePageSize - 1);
+	}
+}
+
+TEST_CASE("Testing bulk insertion")
+{
+	uint64_t nrOfAllocations{};
+	Array<int, CountingAllocator<int>> arr{ CountingAllocator<int>{ &nrOfAllocations } };
+
+	SECTION("Adding a range reallocates at most once")
+	{
+		std::vector<int> source(1000);
+		std::iota(source.begin(), source.end(), 0);
+
+		arr.AddRange(source.data(), source.size());
+		REQUIRE(nrOfAllocations == 1);
+
+		arr.AddRange(arr.begin(), arr.end());
+		REQUIRE(nrOfAllocations == 2);
+		REQUIRE(arr.Size() == 2000);
+
+		for (int i{}; i < 2000; ++i)
+			REQUIRE(arr[i] == i % 1000);
+
+		arr.AddRange({ 1, 2, 3 });
+		REQUIRE(nrOfAllocations == 3);
+		REQUIRE(arr.Back() == 3);
+	}
+
+	SECTION("Constructing from a range allocates exactly once")
+	{
+		Array<int, CountingAllocator<int>> sized{ 1000_size, CountingAllocator<int>{ &nrOfAllocations } };
+		REQUIRE(nrOfAllocations == 1);
+		REQUIRE(sized.Capacity() == 1000);
+
+		Array<int, CountingAllocator<int>> filled{ 1000_size, 5, CountingAllocator<int>{ &nrOfAllocations } };
+		REQUIRE(nrOfAllocations == 2);
+		REQUIRE(filled.Back() == 5);
+
+		Array<int, CountingAllocator<int>> copied{ filled.begin(), filled.end(), CountingAllocator<int>{ &nrOfAllocations } };
+		REQUIRE(nrOfAllocations == 3);
+		REQUIRE(copied == filled);
+	}
+
+	SECTION("Inserting a range in the middle reallocates at most once")
+	{
+		for (int i{}; i < 10; ++i)
+			arr.Add(i);
+
+		const uint64_t allocationsBefore{ nrOfAllocations };
+
+		std::vector<int> source(1000, -1);
+		arr.InsertRange(5, source.data(), source.size());
+
+		REQUIRE(nrOfAllocations == allocationsBefore + 1);
+		REQUIRE(arr.Size() == 1010);
+		REQUIRE(arr[4] == 4);
+		REQUIRE(arr[5] == -1);
+		REQUIRE(arr[1004] == -1);
+		REQUIRE(arr[1005] == 5);
+		REQUIRE(arr.Back() == 9);
+
+		arr.EraseRange(5, 1000);
+		arr.InsertRange(0, arr.begin() + 8, arr.end());
+		arr.InsertN(2, 3, arr[0]);
+		arr.InsertRange(arr.Size(), { 10, 11 });
+
+		const Array<int> expected{ 8, 9, 8, 8, 8, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11 };
+		REQUIRE(arr.Size() == expected.Size());
+
+		for (uint64_t i{}; i < expected.Size(); ++i)
+			REQUIRE(arr[i] == expected[i]);
+	}
+
+	SECTION("Inserting non-trivial elements in the middle")
+	{
+		Array<std::string> strings{ "a", "e" };
+
+		strings.InsertRange(1, { "b", "c", "d" });
+		strings.InsertN(0, 2, std::string{ "z" });
+		strings.Insert(3, "x");
+
+		REQUIRE(strings.Size() == 8);
+		REQUIRE(strings[0] == "z");
+		REQUIRE(strings[2] == "a");
+		REQUIRE(strings[3] == "x");
+		REQUIRE(strings[4] == "b");
+		REQUIRE(strings.Back() == "e");
+	}
+
+	SECTION("Filling with one of our own elements")
+	{
+		Array<std::string> strings{ "a", "b" };
+
+		strings.Resize(100, std::string{ "c" });
+		strings.Resize(1000, __MOVE(std::string{ strings[0] }));
+
+		REQUIRE(strings[99] == "c");
+		REQUIRE(strings.Back() == "a");
+	}
+
+	SECTION("Inserting elements whose copy throws leaves the Array as it was")
+	{
+		{
+			Array<ThrowingCopy> throwing{};
+
+			for (int i{}; i < 6; ++i)
+				throwing.Add(ThrowingCopy{ i });
+
+			const ThrowingCopy val{ 42 };
+			const ThrowingCopy source[3]{ 7, 8, 9 };
+
+			ThrowingCopy::CopiesBeforeThrow = 0;
+			REQUIRE_THROWS_AS(throwing.Insert(3, val), std::runtime_error);
+
+			ThrowingCopy::CopiesBeforeThrow = 2;
+			REQUIRE_THROWS_AS(throwing.InsertN(3, 4, val), std::runtime_error);
+
+			ThrowingCopy::CopiesBeforeThrow = 2;
+			REQUIRE_THROWS_AS(throwing.InsertN(0, 4, val), std::runtime_error);
+
+			ThrowingCopy::CopiesBeforeThrow = 1;
+			REQUIRE_THROWS_AS(throwing.InsertRange(2, source, 3), std::runtime_error);
+
+			ThrowingCopy::CopiesBeforeThrow = -1;
+
+			REQUIRE(throwing.Size() == 6);
+
+			for (int i{}; i < 6; ++i)
+				REQUIRE(throwing[i].Value == i);
+
+			REQUIRE(ThrowingCopy::NrAlive == 6 + 1 + 3);
+		}
+
+		REQUIRE(ThrowingCopy::NrAlive == 0);
+	}
+
+	SECTION("Appending elements whose copy throws keeps the ones already built")
+	{
+		{
+			Array<ThrowingCopy> throwing{};
+
+			const ThrowingCopy val{ 42 };
+			const ThrowingCopy source[3]{ 7, 8, 9 };
+
+			ThrowingCopy::CopiesBeforeThrow = 2;
+			REQUIRE_THROWS_AS(throwing.AddRange(source, 3), std::runtime_error);
+			REQUIRE(throwing.Size() == 2);
+
+			ThrowingCopy::CopiesBeforeThrow = 3;
+			REQUIRE_THROWS_AS(throwing.Resize(10, val), std::runtime_error);
+			REQUIRE(throwing.Size() == 5);
+
+			ThrowingCopy::CopiesBeforeThrow = -1;
+
+			REQUIRE(throwing[1].Value == 8);
+			REQUIRE(throwing.Back().Value == 42);
+			REQUIRE(ThrowingCopy::NrAlive == 5 + 1 + 3);
+		}
+
+		REQUIRE(ThrowingCopy::NrAlive == 0);
+	}
+}
+
+TEST_CASE("Testing selection vectors")
+{
+	Array<int> arr{};
+
+	for (int i{}; i < 100; ++i)
+		arr.Add(i % 10);
+
+	SECTION("Selecting positions instead of elements")
+	{
+		const Array<uint64_t> fives{ arr.FindAllIndices(5) };
+		REQUIRE(fives.Size() == 10);
+		REQUIRE(fives.Capacity() < arr.Size());
+
+		for (uint64_t i{}; i < fives.Size(); ++i)
+			REQUIRE(fives[i] == i * 10 + 5);
+
+		Array<uint32_t> selection{ arr.SelectIndices<uint32_t>([](const int a)->bool { return a > 5; }) };
+		REQUIRE(selection.Size() == 40);
+
+		arr.RefineIndices(selection, [](const int a)->bool { return a % 2 == 0; });
+		REQUIRE(selection.Size() == 20);
+		REQUIRE(selection.Front() == 6);
+		REQUIRE(selection.Back() == 98);
+
+		Array<int> materialized{};
+		arr.Gather(selection, materialized);
+
+		REQUIRE(materialized.Size() == 20);
+		REQUIRE(materialized[0] == 6);
+		REQUIRE(materialized[1] == 8);
+	}
+
+	SECTION("Appending into an output Array")
+	{
+		Array<int> out{ -1 };
+
+		arr.FindAll(3, out);
+		arr.Select([](const int a)->bool { return a == 9; }, out);
+
+		REQUIRE(out.Size() == 21);
+		REQUIRE(out.Front() == -1);
+		REQUIRE(out[10] == 3);
+		REQUIRE(out.Back() == 9);
+	}
+
+	SECTION("Looking at the elements through a span")
+	{
+		std::span<const int> span{ std::as_const(arr).Span(10, 10) };
+
+		REQUIRE(span.size() == 10);
+		REQUIRE(std::accumulate(span.begin(), span.end(), 0) == 45);
+
+		arr.Span()[0] = 42;
+		REQUIRE(arr.Front() == 42);
+	}
+}
+
+TEST_CASE("Testing copy assignment")
+{
+	uint64_t nrOfAllocations{};
+	const CountingAllocator<int> alloc{ &nrOfAllocations };
+
+	SECTION("Assigning reuses the capacity we already have")
+	{
+		Array<int, CountingAllocator<int>> source{ 1000_size, 5, alloc };
+		Array<int, CountingAllocator<int>> snapshot{ alloc };
+
+		snapshot = source;
+		REQUIRE(nrOfAllocations == 2);
+
+		for (int i{}; i < 10; ++i)
+		{
+			source.Resize(1000 - i * 50, i);
+			snapshot = source;
+
+			REQUIRE(snapshot == source);
+		}
+
+		REQUIRE(nrOfAllocations == 2);
+		REQUIRE(snapshot.Size() == 550);
+	}
+
+	SECTION("Assigning over non-trivial elements")
+	{
+		const int aliveAtStart{ LifetimeCounter::Alive() };
+
+		{
+			Array<LifetimeCounter> big{ 20_size, LifetimeCounter{ 1 } };
+			Array<LifetimeCounter> small{ 5_size, LifetimeCounter{ 2 } };
+			Array<LifetimeCounter> arr{ Capacity_P{ 20 } };
+
+			for (int i{}; i < 10; ++i)
+				arr.AddFront(i);
+
+			arr = big;
+			REQUIRE(arr == big);
+			REQUIRE(arr.Capacity() == 20);
+
+			arr = small;
+			REQUIRE(arr == small);
+			REQUIRE(LifetimeCounter::Alive() == aliveAtStart + 30);
+		}
+
+		REQUIRE(LifetimeCounter::Alive() == aliveAtStart);
+	}
+}
+
+TEST_CASE("Testing growing without initialising")
+{
+	uint64_t nrOfAllocations{};
+	Array<int, CountingAllocator<int>> arr{ CountingAllocator<int>{ &nrOfAllocations } };
+
+	SECTION("Producers writing into the new tail")
+	{
+		for (int i{}; i < 3; ++i)
+		{
+			std::span<int> tail{ arr.GrowBy(1000) };
+			REQUIRE(tail.size() == 1000);
+
+			std::iota(tail.begin(), tail.end(), i * 1000);
+		}
+
+		REQUIRE(arr.Size() == 3000);
+
+		for (int i{}; i < 3000; ++i)
+			REQUIRE(arr[i] == i);
+
+		arr.ResizeUninitialized(10);
+		REQUIRE(arr.Size() == 10);
+		REQUIRE(arr.Back() == 9);
+	}
+
+	SECTION("Resizing reallocates at most once")
+	{
+		arr.ResizeUninitialized(1000);
+		REQUIRE(nrOfAllocations == 1);
+
+		arr.ResizeDefaultInit(10'000);
+		REQUIRE(nrOfAllocations == 2);
+		REQUIRE(arr.Size() == 10'000);
+
+		arr.Resize(20'000);
+		REQUIRE(nrOfAllocations == 3);
+		REQUIRE(arr.Back() == 0);
+	}
+
+	SECTION("Default initialising non-trivial types")
+	{
+		Array<std::string> strings{ "a" };
+
+		strings.ResizeDefaultInit(100);
+		REQUIRE(strings.Size() == 100);
+		REQUIRE(strings.Front() == "a");
+		REQUIRE(strings.Back().empty());
+
+		strings.ResizeDefaultInit(1);
+		REQUIRE(strings.Size() == 1);
+	}
+}
+
+TEST_CASE("Testing front operations")
+{
+	SECTION("Inserting and erasing in the middle keeps the elements in front of it in place")
+	{
+		Array<int> arr{};
+
+		for (int i{}; i < 100; ++i)
+			arr.Add(i);
+
+		/* Pointers and iterators to elements before the position stay valid, even close to the front */
+		const int* const pElement{ &arr[2] };
+		const Array<int>::It it{ arr.begin() + 5 };
+
+		arr.EraseByIndex(10);
+		arr.Insert(20, -1);
+		arr.EraseRange(8, 4);
+		arr.InsertN(15, 3, -2);
+
+		REQUIRE(&arr[2] == pElement);
+		REQUIRE(*pElement == 2);
+		REQUIRE(it == arr.begin() + 5);
+		REQUIRE(*it == 5);
+	}
+
+	SECTION("Adding to the front only reallocates when growing")
+	{
+		uint64_t nrOfAllocations{};
+		Array<int, CountingAllocator<int>> arr{ CountingAllocator<int>{ &nrOfAllocations } };
+
+		for (int i{}; i < 10'000; ++i)
+			arr.AddFront(i);
+
+		REQUIRE(nrOfAllocations < 30);
+		REQUIRE(arr.Front() == 9'999);
+		REQUIRE(arr.Back() == 0);
+
+		for (int i{}; i < 10'000; ++i)
+			REQUIRE(arr[i] == 9'999 - i);
+	}
+
+	SECTION("Using the Array as a queue keeps its capacity bounded")
+	{
+		Array<int> arr{};
+
+		for (int i{}; i < 100; ++i)
+			arr.Add(i);
+
+		bool bInOrder{ true };
+		for (int i{ 100 }; i < 100'000; ++i)
+		{
+			bInOrder &= arr.Front() == i - 100;
+
+			arr.PopFront();
+			arr.Add(i);
+		}
+
+		REQUIRE(bInOrder);
+		REQUIRE(arr.Size() == 100);
+		REQUIRE(arr.Capacity() <= 400);
+		REQUIRE(arr.Front() == 99'900);
+	}
+
+	SECTION("Mixing front and back operations")
+	{
+		const int aliveAtStart{ LifetimeCounter::Alive() };
+
+		{
+			Array<LifetimeCounter> arr{};
+			std::deque<int> expected{};
+
+			Lcg rng{ 12345u };
+			const auto next{ [&rng](const uint32_t max)->uint32_t { return (rng.Next() >> 8u) % max; } };
+
+			for (int i{}; i < 20'000; ++i)
+			{
+				const uint32_t operation{ next(8u) };
+
+				if (operation <= 1u)
+				{
+					arr.AddFront(i);
+					expected.push_front(i);
+				}
+				else if (operation <= 3u)
+				{
+					arr.Add(i);
+					expected.push_back(i);
+				}
+				else if (operation == 4u && !expected.empty())
+				{
+					arr.PopFront();
+					expected.pop_front();
+				}
+				else if (operation == 5u && !expected.empty())
+				{
+					arr.Pop();
+					expected.pop_back();
+				}
+				else if (operation == 6u)
+				{
+					const uint32_t index{ next(static_cast<uint32_t>(expected.size()) + 1u) };
+					arr.Insert(index, i);
+					expected.insert(expected.begin() + index, i);
+				}
+				else if (!expected.empty())
+				{
+					const uint32_t index{ next(static_cast<uint32_t>(expected.size())) };
+					arr.EraseByIndex(index);
+					expected.erase(expected.begin() + index);
+				}
+			}
+
+			REQUIRE(arr.Size() == expected.size());
+
+			for (uint64_t i{}; i < expected.size(); ++i)
+				REQUIRE(arr[i].Value == expected[i]);
+
+			arr.EraseRange(1, arr.Size() / 3);
+			expected.erase(expected.begin() + 1, expected.begin() + 1 + expected.size() / 3);
+			arr.ShrinkToFit();
+			REQUIRE(arr.Capacity() == arr.Size());
+
+			for (uint64_t i{}; i < expected.size(); ++i)
+				REQUIRE(arr[i].Value == expected[i]);
+
+			REQUIRE(LifetimeCounter::Alive() == aliveAtStart + static_cast<int>(expected.size()));
+		}
+
+		REQUIRE(LifetimeCounter::Alive() == aliveAtStart);
+	}
+
+	SECTION("Front room with inline storage and allocators that grow in place")
+	{
+		SmallArray<int, 8> small{};
+
+		for (int i{}; i < 8; ++i)
+			small.AddFront(i);
+
+		small.PopFront();
+		small.Add(-1);
+		REQUIRE(small.Front() == 6);
+		REQUIRE(small.Back() == -1);
+
+		Array<int, ReallocAllocator<int>> arr{};
+
+		for (int i{}; i < 100; ++i)
+			arr.AddFront(i);
+
+		for (int i{}; i < 10'000; ++i)
+			arr.Add(i);
+
+		arr.Reserve(arr.Capacity());
+		REQUIRE(arr.Front() == 99);
+		REQUIRE(arr[99] == 0);
+		REQUIRE(arr.Back() == 9'999);
+	}
+}
+
+TEST_CASE("Testing Basic Array of characters")
+{
+	Array<char> arr{};
+
+	SECTION("Adding characters")
+	{
+		const std::string letters{ "abcdefgh" };
+
+		for (const char c : letters)
+			arr.Add(c);
+
+		for (size_t i{}; i < arr.Size(); ++i)
+			REQUIRE(arr[i] == letters[i]);
+	}
+
+	SECTION("Adding Character to the front")
+	{
+		const std::string letters{ "abcdefgh" };
+
+		for (const char c : letters)
+			arr.AddFront(c);
+
+		size_t counter{};
+		for (int i{ static_cast<int>(arr.Size() - 1) }; i >= 0; --i)
+			REQUIRE(letters[i] == arr[counter++]);
+	}
+}
+#endif // ARRAY_TESTS
+
+#else
+#define STL
+//#define CUSTOM
+//#define REALLOC_BENCHMARK
+//#define GROWTH_BENCHMARK
+//#define ARENA_BENCHMARK
+//#define HUGEPAGE_BENCHMARK
+//#define BULK_BENCHMARK
+//#define DEQUE_BENCHMARK
+//#define SORT_BENCHMARK
+//#define RADIX_BENCHMARK
+//#define PARALLEL_SORT_BENCHMARK
+
+#ifdef REALLOC_BENCHMARK
+template<typename ArrayType>
+long long TimeGrowth(const uint64_t nrOfElements)
+{
+	const std::chrono::steady_clock::time_point t1{ std::chrono::steady_clock::now() };
+
+	ArrayType container{};
+
+	for (uint64_t i{}; i < nrOfElements; ++i)
+		container.Add(static_cast<int>(i));
+
+	const std::chrono::steady_clock::time_point t2{ std::chrono::steady_clock::now() };
+
+	return std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count();
+}
+
+void RunReallocBenchmark()
+{
+	for (const uint64_t nrOfElements : { 1'000'000ull, 10'000'000ull, 100'000'000ull, 1'000'000'000ull })
+	{
+		std::cout << "Amount of push_back: " << nrOfElements << "\n";
+		std::cout << "Allocate and copy (in milliseconds): " << TimeGrowth<Array<int>>(nrOfElements) << "\n";
+		std::cout << "Realloc and mremap (in milliseconds): " << TimeGrowth<Array<int, ReallocAllocator<int>>>(nrOfElements) << "\n";
+	}
+}
+#endif
+
+#ifdef GROWTH_BENCHMARK
+template<typename Policy>
+void BenchmarkGrowthPolicy(const char* pName, const uint64_t nrOfElements)
+{
+	Array<int, std::allocator<int>, Policy> container{};
+
+	uint64_t nrOfReallocations{};
+	uint64_t copyVolume{};
+
+	const std::chrono::steady_clock::time_point t1{ std::chrono::steady_clock::now() };
+
+	for (uint64_t i{}; i < nrOfElements; ++i)
+	{
+		const uint64_t oldCap{ container.Capacity() };
+
+		container.Add(static_cast<int>(i));
+
+		if (container.Capacity() != oldCap)
+		{
+			++nrOfReallocations;
+			copyVolume += i * sizeof(int);
+		}
+	}
+
+	const std::chrono::steady_clock::time_point t2{ std::chrono::steady_clock::now() };
+
+	std::cout << pName << ": " << std::chrono::duration_cast<std::chrono::microseconds>(t2 - t1).count() << " microseconds, "
+		<< nrOfReallocations << " reallocations, "
+		<< copyVolume << " bytes copied, "
+		<< (container.Capacity() - container.Size()) * sizeof(int) << " bytes slack\n";
+}
+
+void RunGrowthBenchmark()
+{
+	for (const uint64_t nrOfElements : { 1'000ull, 100'000ull, 10'000'000ull })
+	{
+		std::cout << "Amount of push_back: " << nrOfElements << "\n";
+		BenchmarkGrowthPolicy<OneAndAHalfGrowth>("1.5x", nrOfElements);
+		BenchmarkGrowthPolicy<DoubleGrowth>("2x", nrOfElements);
+		BenchmarkGrowthPolicy<GoldenRatioGrowth>("Golden ratio", nrOfElements);
+		BenchmarkGrowthPolicy<PageRoundedGrowth<>>("Page rounded", nrOfElements);
+		BenchmarkGrowthPolicy<SizeClassGrowth<>>("Size class", nrOfElements);
+	}
+}
+#endif
+
+#ifdef ARENA_BENCHMARK
+template<typename ArrayType, typename ... Ts>
+uint64_t RunFrame(const uint64_t nrOfElements, Ts&&... allocArgs)
+{
+	ArrayType arr{ Capacity_P{ nrOfElements }, allocArgs... };
+
+	for (uint64_t i{}; i < nrOfElements; ++i)
+		arr.Add(static_cast<int>(i % 100));
+
+	uint64_t nrOfMatches{};
+
+	/* A frame of short-lived filter results */
+	for (int i{}; i < 100; ++i)
+	{
+		nrOfMatches += arr.FindAll(i).Size();
+		nrOfMatches += arr.Select([i](const int a)->bool { return a < i; }).Size();
+	}
+
+	return nrOfMatches;
+}
+
+void RunArenaBenchmark()
+{
+	const int nrOfFrames{ 100 };
+
+	for (const uint64_t nrOfElements : { 100ull, 10'000ull, 100'000ull })
+	{
+		std::cout << "Amount of elements: " << nrOfElements << "\n";
+
+		uint64_t checksum{};
+
+		std::chrono::steady_clock::time_point t1{ std::chrono::steady_clock::now() };
+
+		for (int frame{}; frame < nrOfFrames; ++frame)
+			checksum += RunFrame<Array<int>>(nrOfElements);
+
+		std::chrono::steady_clock::time_point t2{ std::chrono::steady_clock::now() };
+
+		std::cout << "Global heap frame (in microseconds): " << std::chrono::duration_cast<std::chrono::microseconds>(t2 - t1).count() / nrOfFrames << "\n";
+
+		Arena arena{};
+
+		t1 = std::chrono::steady_clock::now();
+
+		for (int frame{}; frame < nrOfFrames; ++frame)
+		{
+			checksum += RunFrame<Array<int, ArenaAllocator<int>>>(nrOfElements, ArenaAllocator<int>{ &arena });
+			arena.Reset();
+		}
+
+		t2 = std::chrono::steady_clock::now();
+
+		std::cout << "Arena frame (in microseconds): " << std::chrono::duration_cast<std::chrono::microseconds>(t2 - t1).count() / nrOfFrames << "\n";
+		std::cout << "Checksum: " << checksum << "\n";
+	}
+}
+#endif
+
+#ifdef HUGEPAGE_BENCHMARK
+template<typename Allocator>
+void BenchmarkAccess(const char* pName, const uint64_t nrOfElements)
+{
+	Array<uint64_t, Allocator> arr{ Capacity_P{ nrOfElements } };
+
+	for (uint64_t i{}; i < nrOfElements; ++i)
+		arr.Add(i);
+
+	std::chrono::steady_clock::time_point t1{ std::chrono::steady_clock::now() };
+
+	uint64_t sum{};
+	for (uint64_t i{}; i < nrOfElements; ++i)
+		sum += arr[i];
+
+	std::chrono::steady_clock::time_point t2{ std::chrono::steady_clock::now() };
+
+	std::cout << pName << " sequential (in milliseconds): " << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "\n";
+
+	t1 = std::chrono::steady_clock::now();
+
+	/* Random reads through a linear congruential generator, every access is a likely TLB miss */
+	uint64_t index{ 1u };
+	for (uint64_t i{}; i < nrOfElements / 8u; ++i)
+	{
+		index = index * 6364136223846793005ull + 1442695040888963407ull;
+		sum += arr[(index >> 16u) % nrOfElements];
+	}
+
+	t2 = std::chrono::steady_clock::now();
+
+	std::cout << pName << " random (in milliseconds): " << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "\n";
+	std::cout << "Checksum: " << sum << "\n";
+}
+
+void RunHugePageBenchmark()
+{
+	for (const uint64_t nrOfBytes : { 1ull << 30u, 4ull << 30u })
+	{
+		const uint64_t nrOfElements{ nrOfBytes / sizeof(uint64_t) };
+
+		std::cout << "Amount of bytes: " << nrOfBytes << "\n";
+		BenchmarkAccess<std::allocator<uint64_t>>("Regular pages", nrOfElements);
+		BenchmarkAccess<HugePageAllocator<uint64_t>>("Huge pages", nrOfElements);
+		BenchmarkAccess<HugePageAllocator<uint64_t, 64, true>>("Huge pages, pre-faulted", nrOfElements);
+	}
+}
+#endif
+
+#ifdef BULK_BENCHMARK
+void RunBulkBenchmark()
+{
+	for (const uint64_t nrOfElements : { 1'000ull, 100'000ull, 1'000'000ull, 10'000'000ull })
+	{
+		std::vector<int> source(nrOfElements);
+		std::iota(source.begin(), source.end(), 0);
+
+		std::cout << "Amount of elements: " << nrOfElements << "\n";
+
+		std::chrono::steady_clock::time_point t1{ std::chrono::steady_clock::now() };
+		{
+			Array<int> arr{};
+
+			for (const int elem : source)
+				arr.Add(elem);
+		}
+		std::chrono::steady_clock::time_point t2{ std::chrono::steady_clock::now() };
+
+		std::cout << "Per-element Add (in microseconds): " << std::chrono::duration_cast<std::chrono::microseconds>(t2 - t1).count() << "\n";
+
+		t1 = std::chrono::steady_clock::now();
+		{
+			Array<int> arr{};
+
+			arr.AddRange(source.data(), source.size());
+		}
+		t2 = std::chrono::steady_clock::now();
+
+		std::cout << "Bulk AddRange (in microseconds): " << std::chrono::duration_cast<std::chrono::microseconds>(t2 - t1).count() << "\n";
+	}
+}
+#endif
+
+#ifdef DEQUE_BENCHMARK
+template<typename Container, typename Function>
+long long TimeQueueOperations(const Function& function)
+{
+	const std::chrono::steady_clock::time_point t1{ std::chrono::steady_clock::now() };
+
+	Container container{};
+	function(container);
+
+	const std::chrono::steady_clock::time_point t2{ std::chrono::steady_clock::now() };
+
+	return std::chrono::duration_cast<std::chrono::microseconds>(t2 - t1).count();
+}
+
+void RunDequeBenchmark()
+{
+	for (const int nrOfElements : { 10'000, 1'000'000, 10'000'000 })
+	{
+		std::cout << "Amount of elements: " << nrOfElements << "\n";
+
+		/* Adding everything to the front */
+		std::cout << "AddFront (in microseconds) Array: " << TimeQueueOperations<Array<int>>([nrOfElements](Array<int>& arr)
+			{
+				for (int i{}; i < nrOfElements; ++i)
+					arr.AddFront(i);
+			});
+		std::cout << ", std::deque: " << TimeQueueOperations<std::deque<int>>([nrOfElements](std::deque<int>& deque)
+			{
+				for (int i{}; i < nrOfElements; ++i)
+					deque.push_front(i);
+			}) << "\n";
+
+		/* A work queue holding 1000 elements at a time */
+		std::cout << "Queue (in microseconds) Array: " << TimeQueueOperations<Array<int>>([nrOfElements](Array<int>& arr)
+			{
+				for (int i{}; i < nrOfElements; ++i)
+				{
+					arr.Add(i);
+
+					if (i >= 1'000)
+						arr.PopFront();
+				}
+			});
+		std::cout << ", std::deque: " << TimeQueueOperations<std::deque<int>>([nrOfElements](std::deque<int>& deque)
+			{
+				for (int i{}; i < nrOfElements; ++i)
+				{
+					deque.push_back(i);
+
+					if (i >= 1'000)
+						deque.pop_front();
+				}
+			}) << "\n";
+
+		/* Filling from both ends and then summing everything */
+		long long sum{};
+		std::cout << "Both ends + iterating (in microseconds) Array: " << TimeQueueOperations<Array<int>>([nrOfElements, &sum](Array<int>& arr)
+			{
+				for (int i{}; i < nrOfElements; ++i)
+					(i & 1) ? arr.AddFront(i) : arr.Add(i);
+
+				for (int i{}; i < 10; ++i)
+					sum += std::accumulate(arr.begin(), arr.end(), 0ll);
+			});
+		std::cout << ", std::deque: " << TimeQueueOperations<std::deque<int>>([nrOfElements, &sum](std::deque<int>& deque)
+			{
+				for (int i{}; i < nrOfElements; ++i)
+					(i & 1) ? deque.push_front(i) : deque.push_back(i);
+
+				for (int i{}; i < 10; ++i)
+					sum += std::accumulate(deque.begin(), deque.end(), 0ll);
+			}) << " (" << sum << ")\n";
+	}
+}
+#endif
+
+#ifdef SORT_BENCHMARK
+enum class SortInput
+{
+	Random,
+	Sorted,
+	Reversed,
+	FewUnique,
+	NearlySorted
+};
+
+std::vector<int> MakeSortInput(const SortInput input, const int nrOfElements)
+{
+	std::vector<int> values(nrOfElements);
+
+	uint32_t seed{ 42u };
+	for (int i{}; i < nrOfElements; ++i)
+	{
+		seed = seed * 1664525u + 1013904223u;
+
+		switch (input)
+		{
+		case SortInput::Random:
+			values[i] = static_cast<int>(seed >> 1u);
+			break;
+		case SortInput::Sorted:
+			values[i] = i;
+			break;
+		case SortInput::Reversed:
+			values[i] = nrOfElements - i;
+			break;
+		case SortInput::FewUnique:
+			values[i] = static_cast<int>(seed >> 28u);
+			break;
+		case SortInput::NearlySorted:
+			/* Sorted with 1% of the elements appended at random */
+			values[i] = i < nrOfElements - nrOfElements / 100 ? i : static_cast<int>(seed % nrOfElements);
+			break;
+		}
+	}
+
+	return values;
+}
+
+template<typename Function>
+long long TimeSort(const std::vector<int>& values, const Function& function)
+{
+	Array<int> arr{};
+	arr.AddRange(values.data(), values.size());
+
+	const std::chrono::steady_clock::time_point t1{ std::chrono::steady_clock::now() };
+
+	function(arr);
+
+	const std::chrono::steady_clock::time_point t2{ std::chrono::steady_clock::now() };
+
+	if (!std::is_sorted(arr.begin(), arr.end()))
+		std::cout << "NOT SORTED! ";
+
+	return std::chrono::duration_cast<std::chrono::microseconds>(t2 - t1).count();
+}
+
+void RunSortBenchmark()
+{
+	const char* const inputNames[]{ "Random", "Sorted", "Reversed", "Few unique", "Nearly sorted" };
+
+	for (const int nrOfElements : { 100'000, 1'000'000, 10'000'000 })
+	{
+		std::cout << "Amount of elements: " << nrOfElements << "\n";
+
+		for (const SortInput input : { SortInput::Random, SortInput::Sorted, SortInput::Reversed, SortInput::FewUnique, SortInput::NearlySorted })
+		{
+			const std::vector<int> values{ MakeSortInput(input, nrOfElements) };
+
+			std::cout << inputNames[static_cast<int>(input)] << " (in microseconds) Array::Sort: "
+				<< TimeSort(values, [](Array<int>& arr) { arr.Sort(); });
+			std::cout << ", Adaptive: "
+				<< TimeSort(values, [](Array<int>& arr) { arr.Sort(SortMode::Adaptive); });
+			std::cout << ", std::stable_sort: "
+				<< TimeSort(values, [](Array<int>& arr) { std::stable_sort(arr.Data(), arr.Data() + arr.Size()); });
+			std::cout << ", Array::SortUnstable: "
+				<< TimeSort(values, [](Array<int>& arr) { arr.SortUnstable(); });
+			std::cout << ", std::sort: "
+				<< TimeSort(values, [](Array<int>& arr) { std::sort(arr.Data(), arr.Data() + arr.Size()); }) << "\n";
+		}
+	}
+}
+#endif
+
+#ifdef RADIX_BENCHMARK
+struct RadixRecord final
+{
+	uint32_t Key;
+	uint32_t Payload;
+};
+
+template<typename T, typename Function>
+long long TimeRadixSort(const std::vector<T>& values, const Function& function)
+{
+	Array<T> arr{};
+	arr.AddRange(values.data(), values.size());
+
+	const std::chrono::steady_clock::time_point t1{ std::chrono::steady_clock::now() };
+
+	function(arr);
+
+	const std::chrono::steady_clock::time_point t2{ std::chrono::steady_clock::now() };
+
+	return std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count();
+}
+
+template<typename T, typename KeyOf>
+void BenchmarkRadixSort(const char* const pName, const std::vector<T>& values, const KeyOf& keyOf)
+{
+	const auto byKey{ [&keyOf](const T& a, const T& b)->bool { return keyOf(a) < keyOf(b); } };
+
+	std::cout << pName << " (in milliseconds) Array::RadixSort: "
+		<< TimeRadixSort(values, [&keyOf](Array<T>& arr) { arr.RadixSort(keyOf); });
+	std::cout << ", Array::SortUnstable: "
+		<< TimeRadixSort(values, [&byKey](Array<T>& arr) { arr.SortUnstable(byKey); });
+	std::cout << ", std::sort: "
+		<< TimeRadixSort(values, [&byKey](Array<T>& arr) { std::sort(arr.Data(), arr.Data() + arr.Size(), byKey); }) << "\n";
+}
+
+void RunRadixBenchmark()
+{
+	for (const uint64_t nrOfElements : { 1'000'000ull, 10'000'000ull, 100'000'000ull })
+	{
+		std::cout << "Amount of elements: " << nrOfElements << "\n";
+
+		std::vector<int> ints(nrOfElements);
+		std::vector<uint64_t> bigInts(nrOfElements);
+		std::vector<float> floats(nrOfElements);
+		std::vector<RadixRecord> records(nrOfElements);
+
+		uint64_t seed{ 42u };
+		for (uint64_t i{}; i < nrOfElements; ++i)
+		{
+			seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+
+			ints[i] = static_cast<int>(seed >> 32u);
+			bigInts[i] = seed ^ (seed >> 29u);
+			floats[i] = static_cast<float>(static_cast<int64_t>(seed >> 40u) - (1ll << 23u)) / 1024.f;
+			records[i] = RadixRecord{ static_cast<uint32_t>(seed >> 32u), static_cast<uint32_t>(i) };
+		}
+
+		BenchmarkRadixSort("int", ints, [](const int value) { return value; });
+		BenchmarkRadixSort("uint64_t", bigInts, [](const uint64_t value) { return value; });
+		BenchmarkRadixSort("float", floats, [](const float value) { return value; });
+		BenchmarkRadixSort("Records keyed by uint32_t", records, [](const RadixRecord& record) { return record.Key; });
+	}
+}
+#endif
+
+#ifdef PARALLEL_SORT_BENCHMARK
+/* Strong scaling: the same arrays sorted with 1, 2, 4, ... threads, up to every hardware thread */
+void RunParallelSortBenchmark()
+{
+	const uint64_t maxNrOfThreads{ ThreadPool::GetHardwareConcurrency() };
+
+	std::vector<uint64_t> threadCounts{};
+	for (uint64_t nrOfThreads{ 1u }; nrOfThreads < maxNrOfThreads; nrOfThreads *= 2u)
+		threadCounts.push_back(nrOfThreads);
+	threadCounts.push_back(maxNrOfThreads);
+
+	for (const uint64_t nrOfElements : { 10'000'000ull, 100'000'000ull })
+	{
+		std::cout << "Amount of elements: " << nrOfElements << "\n";
+
+		std::vector<int> values(nrOfElements);
+
+		uint64_t seed{ 42u };
+		for (int& value : values)
+		{
+			seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+			value = static_cast<int>(seed >> 32u);
+		}
+
+		Array<int> arr{};
+		long long singleThreadedTime{};
+
+		for (const uint64_t nrOfThreads : threadCounts)
+		{
+			ThreadPool pool{ nrOfThreads };
+
+			arr.Clear();
+			arr.AddRange(values.data(), values.size());
+
+			const std::chrono::steady_clock::time_point t1{ std::chrono::steady_clock::now() };
+
+			arr.ParallelSort([](const int a, const int b)->bool { return a < b; }, pool);
+
+			const std::chrono::steady_clock::time_point t2{ std::chrono::steady_clock::now() };
+
+			const long long time{ std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() };
+			if (nrOfThreads == 1u)
+				singleThreadedTime = time;
+
+			if (!std::is_sorted(arr.begin(), arr.end()))
+				std::cout << "NOT SORTED! ";
+
+			std::cout << "Threads: " << nrOfThreads << ", time (in milliseconds): " << time
+				<< ", speedup: " << static_cast<double>(singleThreadedTime) / static_cast<double>(time > 0 ? time : 1) << "\n";
+		}
+	}
+}
+#endif
+
+int main(int argc, char* argv[])
+{
+#ifdef REALLOC_BENCHMARK
+	RunReallocBenchmark();
+	return 0;
+#endif
+#ifdef GROWTH_BENCHMARK
+	RunGrowthBenchmark();
+	return 0;
+#endif
+#ifdef ARENA_BENCHMARK
+	RunArenaBenchmark();
+	return 0;
+#endif
+#ifdef HUGEPAGE_BENCHMARK
+	RunHugePageBenchmark();
+	return 0;
+#endif
+#ifdef BULK_BENCHMARK
+	RunBulkBenchmark();
+	return 0;
+#endif
+#ifdef DEQUE_BENCHMARK
+	RunDequeBenchmark();
+	return 0;
+#endif
+#ifdef SORT_BENCHMARK
+	RunSortBenchmark();
+	return 0;
+#endif
+#ifdef RADIX_BENCHMARK
+	RunRadixBenchmark();
+	return 0;
+#endif
+#ifdef PARALLEL_SORT_BENCHMARK
+	RunParallelSortBenchmark();
+	return 0;
+#endif
+
 	using Timepoint = std::chrono::steady_clock::time_point;
 
 	const int amountOfIterations{ 100 };